@@ -0,0 +1,84 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * The outcome of a batch decode: the decoded value or the failure of each
+ * document, by position into the batch.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class BatchResult
+{
+    /**
+     * Create a new batch result.
+     *
+     * @param Vector<mixed> $values The decoded values, null for the failed documents.
+     * @param Map<int, Ivyhjk\Xml\Exception\XmlException> $errors The failures, by position.
+     *
+     * @return void
+     */
+    public function __construct(private Vector<mixed> $values, private Map<int, XmlException> $errors) : void
+    {
+
+    }
+
+    /**
+     * Get the decoded values, null for the failed documents.
+     *
+     * @return Vector<mixed>
+     */
+    public function getValues() : Vector<mixed>
+    {
+        return $this->values;
+    }
+
+    /**
+     * Get the failures, by position into the batch.
+     *
+     * @return Map<int, Ivyhjk\Xml\Exception\XmlException>
+     */
+    public function getErrors() : Map<int, XmlException>
+    {
+        return $this->errors;
+    }
+
+    /**
+     * Get the failure of a document.
+     *
+     * @param int $index The document position into the batch.
+     *
+     * @return ?Ivyhjk\Xml\Exception\XmlException Null when it was decoded.
+     */
+    public function getError(int $index) : ?XmlException
+    {
+        return $this->errors->get($index);
+    }
+
+    /**
+     * Check if any document failed.
+     *
+     * @return bool
+     */
+    public function hasErrors() : bool
+    {
+        return ! $this->errors->isEmpty();
+    }
+
+    /**
+     * Get the number of documents into the batch.
+     *
+     * @return int
+     */
+    public function count() : int
+    {
+        return $this->values->count();
+    }
+}
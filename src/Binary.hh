@@ -0,0 +1,720 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use DateTimeInterface;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Metadata\MetadataCache;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Compact binary encoding of the XML RPC value model, for internal hops
+ * where both ends can negotiate it. The values are encoded and decoded with
+ * the same rules than RPC::encode and RPC::decode.
+ *
+ * A document is the MAGIC header, the params count and the params. Every
+ * value is a tag byte followed by its payload: lengths and counts are
+ * unsigned LEB128 varints, integers are zigzag varints, doubles are 8 bytes
+ * little endian, strings, base64 and dates are length prefixed bytes,
+ * structs are a count of (name, value) pairs and arrays a count of values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Binary
+{
+    /**
+     * The media type to negotiate the binary encoding.
+     *
+     * @var string
+     */
+    const string CONTENT_TYPE = 'application/x-xmlrpc-binary';
+
+    /**
+     * The document header: a signature and the format version.
+     *
+     * @var string
+     */
+    const string MAGIC = "XRB\x01";
+
+    /**
+     * The value tags.
+     *
+     * @var int
+     */
+    const int TAG_STRING = 0x01;
+    const int TAG_INT = 0x02;
+    const int TAG_I4 = 0x03;
+    const int TAG_DOUBLE = 0x04;
+    const int TAG_STRUCT = 0x05;
+    const int TAG_ARRAY = 0x06;
+    const int TAG_BASE64 = 0x07;
+    const int TAG_DATETIME = 0x08;
+
+    /**
+     * The longest varint of a 64 bits integer, in bytes.
+     *
+     * @var int
+     */
+    const int MAX_VARINT_SIZE = 10;
+
+    /**
+     * Whether the machine stores the doubles big endian.
+     *
+     * @var ?bool
+     */
+    private static ?bool $bigEndian = null;
+
+    /**
+     * The read position into the data.
+     *
+     * @var int
+     */
+    private int $offset = 0;
+
+    /**
+     * Generate a new reader.
+     *
+     * @param string $data The encoded document.
+     *
+     * @return void
+     */
+    private function __construct(private string $data) : void
+    {
+
+    }
+
+    /**
+     * Encode parameters into the binary format.
+     *
+     * A vec (or a PHP list) is spread into one param per item, anything
+     * else is sent as a single param (like RPC::encode).
+     *
+     * @param mixed $parameters RPC method args.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    public static function encode(mixed $parameters) : string
+    {
+        if ( ! Params::isSpread($parameters)) {
+            $parameters = Vector{$parameters};
+        }
+
+        invariant($parameters instanceof Traversable, 'A list of parameters was expected.');
+
+        $values = new Vector($parameters);
+
+        $buffer = static::MAGIC . static::encodeLength($values->count());
+
+        // Pending (prefix, value, depth): the prefix is the encoded member
+        // name written before the value, if any.
+        $stack = Vector{};
+
+        for ($i = $values->count() - 1; $i >= 0; $i--) {
+            $stack->add(tuple('', $values->at($i), 1));
+        }
+
+        while ( ! $stack->isEmpty()) {
+            list($prefix, $value, $depth) = $stack->pop();
+
+            $buffer .= $prefix . static::encodeValue($value, $depth, $stack);
+        }
+
+        return $buffer;
+    }
+
+    /**
+     * Decode a binary document.
+     *
+     * @param string $data The encoded document.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections or Hack arrays.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function decode(string $data, OutputMode $mode = OutputMode::COLLECTION) : mixed
+    {
+        if ($mode === OutputMode::COLUMNAR) {
+            throw new XmlException('The binary format does not decode into columns.');
+        }
+
+        $reader = new Binary($data);
+
+        if ($reader->readBytes(\strlen(static::MAGIC)) !== static::MAGIC) {
+            throw new XmlException('Invalid binary document header.');
+        }
+
+        $decoded = Vector{};
+
+        // Open containers: (member names for structs, values, size).
+        $frames = Vector{};
+        $frames->add(tuple(null, $decoded, $reader->readCount()));
+
+        while (true) {
+            list($names, $values, $size) = $frames->lastValue();
+
+            if ($values->count() === $size) {
+                $frames->pop();
+
+                if ($frames->isEmpty()) {
+                    break;
+                }
+
+                $frames->lastValue()[1]->add(static::build($names, $values, $mode));
+
+                continue;
+            }
+
+            if ($frames->count() > Config::getMaxDepth()) {
+                throw new DepthLimitExceeded(Config::getMaxDepth());
+            }
+
+            if ($names !== null) {
+                $names->add($reader->readString());
+            }
+
+            $tag = $reader->readByte();
+
+            switch ($tag) {
+                case self::TAG_STRING:
+                    $values->add($reader->readString());
+                    break;
+                case self::TAG_INT:
+                    $values->add($reader->readInt());
+                    break;
+                case self::TAG_I4:
+                    $int = $reader->readInt();
+
+                    if ($int < -2147483648 || $int > 2147483647) {
+                        throw new InvalidValueException(\sprintf('Integer "%d" out of the i4 range.', $int));
+                    }
+
+                    $values->add($int);
+                    break;
+                case self::TAG_DOUBLE:
+                    $values->add(static::unpackDouble($reader->readBytes(8)));
+                    break;
+                case self::TAG_STRUCT:
+                    $frames->add(tuple(Vector{}, Vector{}, $reader->readCount()));
+                    break;
+                case self::TAG_ARRAY:
+                    $frames->add(tuple(null, Vector{}, $reader->readCount()));
+                    break;
+                case self::TAG_BASE64:
+                    $values->add($reader->readBinary());
+                    break;
+                case self::TAG_DATETIME:
+                    $values->add(new Timestamp($reader->readString()));
+                    break;
+                default:
+                    throw new XmlException(\sprintf('Unknown binary tag 0x%02x.', $tag));
+            }
+        }
+
+        if ($reader->offset !== \strlen($data)) {
+            throw new XmlException('Trailing bytes after the binary document.');
+        }
+
+        if ($decoded->count() === 1) {
+            return $decoded->firstValue();
+        }
+
+        return Value::toList($decoded, $mode);
+    }
+
+    /**
+     * Encode the tag and the payload of a single value, nested values are
+     * pushed into the given stack.
+     *
+     * @param mixed $value The value to encode.
+     * @param int $depth The nesting level of the value.
+     * @param Vector<(string, mixed, int)> $stack The pending values.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    private static function encodeValue(mixed $value, int $depth, Vector<(string, mixed, int)> $stack) : string
+    {
+        if ($depth > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        if (\is_int($value)) {
+            return \chr(self::TAG_INT) . static::encodeInt($value);
+        }
+
+        if (\is_string($value)) {
+            return \chr(self::TAG_STRING) . static::encodeString($value);
+        }
+
+        if (\is_float($value)) {
+            return \chr(self::TAG_DOUBLE) . static::packDouble($value);
+        }
+
+        $items = Vector{};
+
+        if ($value instanceof Struct) {
+            foreach ($value->getMembers() as $member) {
+                $items->add(tuple($member->getName(), static::unwrap($member->getValue())));
+            }
+
+            return static::pushItems(self::TAG_STRUCT, $items, $depth, $stack);
+        }
+
+        if ($value instanceof ArrayData) {
+            foreach ($value->getValues() as $item) {
+                $items->add(tuple(null, static::unwrap($item)));
+            }
+
+            return static::pushItems(self::TAG_ARRAY, $items, $depth, $stack);
+        }
+
+        // The registered handlers write XML, there is no binary tag for them.
+        if (TypeRegistry::getEncoder($value) !== null) {
+            throw new UnsupportedValueType(\is_object($value) ? \get_class($value) : \gettype($value));
+        }
+
+        if ($value instanceof TypedList) {
+            $type = $value->getType();
+
+            // Scalar items take the declared type, as the XML encoders do.
+            if ($type !== ValueType::STRUCT && $type !== ValueType::ARRAY) {
+                return static::encodeTypedScalars($value, $type, $depth + 1);
+            }
+        }
+
+        if ($value instanceof TypedList || Value::isList($value)) {
+            $list = $value instanceof TypedList ? $value->getItems() : $value;
+
+            invariant($list instanceof Traversable, 'A list was expected.');
+
+            foreach ($list as $item) {
+                $items->add(tuple(null, $item));
+            }
+
+            return static::pushItems(self::TAG_ARRAY, $items, $depth, $stack);
+        }
+
+        if ($value instanceof Timestamp || $value instanceof DateTimeInterface) {
+            $timestamp = $value instanceof Timestamp ? $value : Timestamp::fromDateTime($value);
+
+            return \chr(self::TAG_DATETIME) . static::encodeString($timestamp->getLexeme());
+        }
+
+        // Binary data, streams are read chunk by chunk into the encoded string.
+        if ($value instanceof Base64 || (\is_resource($value) && \get_resource_type($value) === 'stream')) {
+            $base64 = $value instanceof Base64 ? $value : Base64::fromStream($value);
+
+            $data = '';
+
+            foreach ($base64->read() as $chunk) {
+                $data .= $chunk;
+            }
+
+            return \chr(self::TAG_BASE64) . static::encodeString($data);
+        }
+
+        if (is_dict($value) || \is_array($value) || $value instanceof KeyedTraversable) {
+            invariant($value instanceof KeyedTraversable, 'A struct was expected.');
+
+            foreach ($value as $memberName => $memberValue) {
+                $items->add(tuple((string) $memberName, $memberValue));
+            }
+
+            return static::pushItems(self::TAG_STRUCT, $items, $depth, $stack);
+        }
+
+        if ( ! \is_object($value) || $value instanceof \Closure) {
+            throw new UnsupportedValueType(\gettype($value));
+        }
+
+        // Plain objects: the public properties, described once per class.
+        $metadata = MetadataCache::get(\get_class($value));
+        $properties = \get_object_vars($value);
+
+        foreach ($metadata->getNames() as $memberName) {
+            // Unset properties, and null as XML RPC has no null.
+            if (($properties[$memberName] ?? null) === null) {
+                continue;
+            }
+
+            $items->add(tuple($memberName, $properties[$memberName]));
+        }
+
+        return static::pushItems(self::TAG_STRUCT, $items, $depth, $stack);
+    }
+
+    /**
+     * Encode an array of scalars of a declared type: each item is read as
+     * its text would be decoded from the XML, and tagged with the type.
+     *
+     * @param Ivyhjk\Xml\Type\TypedList $list
+     * @param Ivyhjk\Xml\Contract\ValueType $type The scalar type.
+     * @param int $depth The nesting level of the items.
+     *
+     * @return string The array tag, count and items.
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    private static function encodeTypedScalars(TypedList $list, ValueType $type, int $depth) : string
+    {
+        if ($depth > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        $buffer = '';
+        $count = 0;
+
+        foreach ($list->getItems() as $item) {
+            $value = Caster::castText((string) $type, TypedList::toText($type, $item));
+
+            switch ($type) {
+                case ValueType::STRING:
+                    $buffer .= \chr(self::TAG_STRING) . static::encodeString((string) $value);
+                    break;
+                case ValueType::I4:
+                    $buffer .= \chr(self::TAG_I4) . static::encodeInt((int) $value);
+                    break;
+                case ValueType::FLOAT:
+                case ValueType::DOUBLE:
+                    $buffer .= \chr(self::TAG_DOUBLE) . static::packDouble((float) $value);
+                    break;
+                case ValueType::BASE64:
+                    // Big values are decoded into a stream.
+                    if (\is_resource($value)) {
+                        $value = \stream_get_contents($value);
+                    }
+
+                    $buffer .= \chr(self::TAG_BASE64) . static::encodeString((string) $value);
+                    break;
+                case ValueType::DATETIME:
+                    invariant($value instanceof Timestamp, 'A date was expected.');
+
+                    $buffer .= \chr(self::TAG_DATETIME) . static::encodeString($value->getLexeme());
+                    break;
+                default:
+                    $buffer .= \chr(self::TAG_INT) . static::encodeInt((int) $value);
+            }
+
+            $count++;
+        }
+
+        return \chr(self::TAG_ARRAY) . static::encodeLength($count) . $buffer;
+    }
+
+    /**
+     * Push the items of a container backwards, so they are popped (and
+     * written) in the original order.
+     *
+     * @param int $tag The container tag.
+     * @param Vector<(?string, mixed)> $items The member names and values.
+     * @param int $depth The nesting level of the container.
+     * @param Vector<(string, mixed, int)> $stack The pending values.
+     *
+     * @return string The container tag and count.
+     */
+    private static function pushItems(
+        int $tag,
+        Vector<(?string, mixed)> $items,
+        int $depth,
+        Vector<(string, mixed, int)> $stack
+    ) : string
+    {
+        for ($i = $items->count() - 1; $i >= 0; $i--) {
+            list($name, $item) = $items->at($i);
+
+            $stack->add(tuple($name === null ? '' : static::encodeString($name), $item, $depth + 1));
+        }
+
+        return \chr($tag) . static::encodeLength($items->count());
+    }
+
+    /**
+     * Get the native value of a Value entity: a single child is the value
+     * itself, many are a list.
+     *
+     * @param Ivyhjk\Xml\Entity\Value $value
+     *
+     * @return mixed
+     */
+    private static function unwrap(Value $value) : mixed
+    {
+        $children = $value->getValues();
+
+        return $children->count() === 1 ? $children->firstValue() : $children;
+    }
+
+    /**
+     * Build a decoded container.
+     *
+     * @param ?Vector<string> $names The member names, null for lists.
+     * @param Vector<mixed> $values The decoded values.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return mixed
+     */
+    private static function build(?Vector<string> $names, Vector<mixed> $values, OutputMode $mode) : mixed
+    {
+        if ($names === null) {
+            return Value::toList($values, $mode);
+        }
+
+        if ($mode === OutputMode::HACK_ARRAY) {
+            $struct = dict[];
+
+            foreach ($names as $i => $name) {
+                $struct[$name] = $values->at($i);
+            }
+
+            return $struct;
+        }
+
+        $struct = Map{};
+
+        foreach ($names as $i => $name) {
+            $struct->set($name, $values->at($i));
+        }
+
+        return $struct;
+    }
+
+    /**
+     * Encode an unsigned varint.
+     *
+     * @param int $length A length or a count.
+     *
+     * @return string
+     */
+    private static function encodeLength(int $length) : string
+    {
+        $bytes = '';
+
+        while (($length & ~0x7F) !== 0) {
+            $bytes .= \chr(($length & 0x7F) | 0x80);
+
+            // Logical shift: the high bits of a zigzag integer are not sign.
+            $length = ($length >> 7) & 0x01FFFFFFFFFFFFFF;
+        }
+
+        return $bytes . \chr($length);
+    }
+
+    /**
+     * Encode a signed integer as a zigzag varint, small magnitudes take
+     * few bytes whatever their sign.
+     *
+     * @param int $value
+     *
+     * @return string
+     */
+    private static function encodeInt(int $value) : string
+    {
+        return static::encodeLength(($value << 1) ^ ($value >> 63));
+    }
+
+    /**
+     * Encode a length prefixed string.
+     *
+     * @param string $value
+     *
+     * @return string
+     */
+    private static function encodeString(string $value) : string
+    {
+        return static::encodeLength(\strlen($value)) . $value;
+    }
+
+    /**
+     * Pack a double into 8 bytes little endian.
+     *
+     * @param float $value
+     *
+     * @return string
+     */
+    private static function packDouble(float $value) : string
+    {
+        $bytes = \pack('d', $value);
+
+        return static::isBigEndian() ? \strrev($bytes) : $bytes;
+    }
+
+    /**
+     * Unpack a double from 8 bytes little endian.
+     *
+     * @param string $bytes
+     *
+     * @return float
+     */
+    private static function unpackDouble(string $bytes) : float
+    {
+        if (static::isBigEndian()) {
+            $bytes = \strrev($bytes);
+        }
+
+        return (float) \unpack('d', $bytes)[1];
+    }
+
+    /**
+     * Check the machine byte order, once.
+     *
+     * @return bool
+     */
+    private static function isBigEndian() : bool
+    {
+        $bigEndian = self::$bigEndian;
+
+        if ($bigEndian === null) {
+            $bigEndian = \pack('S', 1) === "\x00\x01";
+
+            self::$bigEndian = $bigEndian;
+        }
+
+        return $bigEndian;
+    }
+
+    /**
+     * Read a single byte.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readByte() : int
+    {
+        if ($this->offset >= \strlen($this->data)) {
+            throw new XmlException('Unexpected end of the binary document.');
+        }
+
+        return \ord($this->data[$this->offset++]);
+    }
+
+    /**
+     * Read some bytes.
+     *
+     * @param int $length
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readBytes(int $length) : string
+    {
+        if ($length > \strlen($this->data) - $this->offset) {
+            throw new XmlException('Unexpected end of the binary document.');
+        }
+
+        $bytes = (string) \substr($this->data, $this->offset, $length);
+
+        $this->offset += $length;
+
+        return $bytes;
+    }
+
+    /**
+     * Read an unsigned varint.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readVarint() : int
+    {
+        $value = 0;
+
+        for ($i = 0; $i < static::MAX_VARINT_SIZE; $i++) {
+            $byte = $this->readByte();
+
+            $value |= ($byte & 0x7F) << (7 * $i);
+
+            if (($byte & 0x80) === 0) {
+                return $value;
+            }
+        }
+
+        throw new XmlException('Invalid binary varint.');
+    }
+
+    /**
+     * Read a length or a count, checked against the remaining bytes so a
+     * corrupted document can not ask for huge allocations.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readCount() : int
+    {
+        $count = $this->readVarint();
+
+        if ($count < 0 || $count > \strlen($this->data) - $this->offset) {
+            throw new XmlException('Unexpected end of the binary document.');
+        }
+
+        return $count;
+    }
+
+    /**
+     * Read a zigzag integer.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readInt() : int
+    {
+        $value = $this->readVarint();
+
+        return (($value >> 1) & \PHP_INT_MAX) ^ -($value & 1);
+    }
+
+    /**
+     * Read a length prefixed string.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readString() : string
+    {
+        return $this->readBytes($this->readCount());
+    }
+
+    /**
+     * Read base64 data, values bigger than Config::getBase64SpillSize() are
+     * written into a temporary stream (like Base64::decode).
+     *
+     * @return mixed The data, or a stream rewound to its start.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function readBinary() : mixed
+    {
+        $length = $this->readCount();
+        $spillSize = Config::getBase64SpillSize();
+
+        if ($length <= $spillSize) {
+            return $this->readBytes($length);
+        }
+
+        $stream = \fopen('php://temp/maxmemory:' . $spillSize, 'w+b');
+
+        for ($written = 0; $written < $length; $written += Base64::CHUNK_SIZE) {
+            \fwrite($stream, $this->readBytes(\min(Base64::CHUNK_SIZE, $length - $written)));
+        }
+
+        \rewind($stream);
+
+        return $stream;
+    }
+}
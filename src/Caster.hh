@@ -3,6 +3,8 @@
 namespace Ivyhjk\Xml;
 
 use SimpleXMLElement;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\Timestamp;
 
 /**
  * Cast given values.
@@ -16,6 +18,20 @@ use SimpleXMLElement;
  */
 class Caster
 {
+    /**
+     * The cast functions of the nodes by type name, built on first use.
+     *
+     * @var ?Map<string, (function(SimpleXMLElement): mixed)>
+     */
+    private static ?Map<string, (function(SimpleXMLElement): mixed)> $casters = null;
+
+    /**
+     * The cast functions of the texts by type name, built on first use.
+     *
+     * @var ?Map<string, (function(string): mixed)>
+     */
+    private static ?Map<string, (function(string): mixed)> $textCasters = null;
+
     /**
      * Cast a value.
      *
@@ -26,21 +42,106 @@ class Caster
      */
     public static function cast(string $to, SimpleXMLElement $value) : mixed
     {
-        switch ($to) {
-            case 'string':
-                return (string) $value;
-                break;
-            case 'int':
-                return (int) $value;
-                break;
-            case 'float':
-                return (float) $value;
-                break;
-            case 'double':
-                return (float) $value;
-                break;
-            default:
-                throw new \Ivyhjk\Xml\Exception\XmlException('Unsuported cast type!.');
+        $caster = static::getCaster($to);
+
+        return $caster($value);
+    }
+
+    /**
+     * Cast the text of a scalar, for the readers that do not hold nodes.
+     * Registered types are decoded from a node rebuilt out of the text.
+     *
+     * @param string $to Cast type name (string, float, etc)
+     * @param string $text The scalar text.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function castText(string $to, string $text) : mixed
+    {
+        $caster = static::getTextCasters()->get($to);
+
+        if ($caster !== null) {
+            return $caster($text);
+        }
+
+        $caster = static::getCaster($to);
+
+        return $caster(new SimpleXMLElement(\sprintf(
+            '<%1$s>%2$s</%1$s>',
+            $to,
+            \htmlspecialchars($text, \ENT_XML1 | \ENT_NOQUOTES, 'UTF-8')
+        )));
+    }
+
+    /**
+     * Get the cast function of a type, so lists of the same type resolve
+     * it only once.
+     *
+     * @param string $to Cast type name (string, float, etc)
+     *
+     * @return (function(SimpleXMLElement): mixed)
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function getCaster(string $to) : (function(SimpleXMLElement): mixed)
+    {
+        $casters = self::$casters;
+
+        if ($casters === null) {
+            $casters = Map{};
+
+            foreach (static::getTextCasters() as $type => $textCaster) {
+                $casters->set($type, (SimpleXMLElement $value) ==> $textCaster((string) $value));
+            }
+
+            self::$casters = $casters;
+        }
+
+        $caster = $casters->get($to);
+
+        if ($caster !== null) {
+            return $caster;
+        }
+
+        $handler = TypeRegistry::getDecoder($to);
+
+        if ($handler === null) {
+            throw new \Ivyhjk\Xml\Exception\XmlException('Unsuported cast type!.');
+        }
+
+        return (SimpleXMLElement $value) ==> $handler->decode($value);
+    }
+
+    /**
+     * Get the cast functions table of the texts, the single definition of
+     * the scalar types.
+     *
+     * @return Map<string, (function(string): mixed)>
+     */
+    private static function getTextCasters() : Map<string, (function(string): mixed)>
+    {
+        $casters = self::$textCasters;
+
+        if ($casters !== null) {
+            return $casters;
         }
+
+        $toInteger = (string $text) ==> Number::parseInt($text);
+        $toDouble = (string $text) ==> Number::parseDouble($text);
+
+        $casters = Map{
+            'string' => (string $text) ==> $text,
+            'int' => $toInteger,
+            'i4' => (string $text) ==> Number::parseInt($text, 32),
+            'i8' => $toInteger,
+            'float' => $toDouble,
+            'double' => $toDouble,
+            'base64' => (string $text) ==> Base64::decode($text),
+            'dateTime.iso8601' => (string $text) ==> new Timestamp($text),
+        };
+
+        self::$textCasters = $casters;
+
+        return $casters;
     }
 }
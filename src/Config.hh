@@ -0,0 +1,200 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use InvalidArgumentException;
+
+/**
+ * Library wide settings.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Config
+{
+    /**
+     * The format of the values kept by the encode and decode caches, to be
+     * changed whenever the library encodes or decodes values differently.
+     *
+     * @var string
+     */
+    const string CACHE_FORMAT = '1.1.0';
+
+    /**
+     * Default nesting limit for encoded and decoded values, within the
+     * libxml default limits (see getParseOptions).
+     *
+     * @var int
+     */
+    const int DEFAULT_MAX_DEPTH = 64;
+
+    /**
+     * The elements nesting libxml accepts without LIBXML_PARSE_HUGE.
+     *
+     * @var int
+     */
+    const int LIBXML_MAX_DEPTH = 256;
+
+    /**
+     * Default size (in bytes) from which decoded base64 values are
+     * returned as a temporary stream instead of a string.
+     *
+     * @var int
+     */
+    const int DEFAULT_BASE64_SPILL_SIZE = 1048576;
+
+    /**
+     * Default number of encoded fragments kept by the fragment cache,
+     * zero disables it.
+     *
+     * @var int
+     */
+    const int DEFAULT_FRAGMENT_CACHE_SIZE = 0;
+
+    /**
+     * The current nesting limit.
+     *
+     * @var int
+     */
+    private static int $maxDepth = self::DEFAULT_MAX_DEPTH;
+
+    /**
+     * The current base64 spill size.
+     *
+     * @var int
+     */
+    private static int $base64SpillSize = self::DEFAULT_BASE64_SPILL_SIZE;
+
+    /**
+     * The current fragment cache size.
+     *
+     * @var int
+     */
+    private static int $fragmentCacheSize = self::DEFAULT_FRAGMENT_CACHE_SIZE;
+
+    /**
+     * Set the maximum nesting level of <value> tags.
+     *
+     * @param int $maxDepth The new limit, must be greater than zero.
+     *
+     * @return void
+     * @throws InvalidArgumentException
+     */
+    public static function setMaxDepth(int $maxDepth) : void
+    {
+        if ($maxDepth < 1) {
+            throw new InvalidArgumentException('The max depth must be greater than zero.');
+        }
+
+        self::$maxDepth = $maxDepth;
+    }
+
+    /**
+     * Get the maximum nesting level of <value> tags.
+     *
+     * @return int
+     */
+    public static function getMaxDepth() : int
+    {
+        return self::$maxDepth;
+    }
+
+    /**
+     * Get the libxml options of the parsers. LIBXML_PARSE_HUGE also lifts
+     * the libxml text size limit, so it is only set when the max depth
+     * needs it: a <value> level takes up to three elements (<value>,
+     * <struct> and <member>, or <value>, <array> and <data>), under the
+     * <methodCall>, <params> and <param> elements.
+     *
+     * @return int
+     */
+    public static function getParseOptions() : int
+    {
+        return 3 * self::$maxDepth + 3 > static::LIBXML_MAX_DEPTH ? \LIBXML_PARSE_HUGE : 0;
+    }
+
+    /**
+     * Set the size (in bytes) from which decoded base64 values are
+     * returned as a temporary stream, spilled to disk past that size.
+     *
+     * @param int $size The new size, zero or more.
+     *
+     * @return void
+     * @throws InvalidArgumentException
+     */
+    public static function setBase64SpillSize(int $size) : void
+    {
+        if ($size < 0) {
+            throw new InvalidArgumentException('The base64 spill size can not be negative.');
+        }
+
+        self::$base64SpillSize = $size;
+    }
+
+    /**
+     * Get the size (in bytes) from which decoded base64 values are
+     * returned as a temporary stream.
+     *
+     * @return int
+     */
+    public static function getBase64SpillSize() : int
+    {
+        return self::$base64SpillSize;
+    }
+
+    /**
+     * Set the number of encoded fragments kept by the fragment cache, the
+     * least recently used are evicted past it.
+     *
+     * @param int $size The new size, zero disables the cache.
+     *
+     * @return void
+     * @throws InvalidArgumentException
+     */
+    public static function setFragmentCacheSize(int $size) : void
+    {
+        if ($size < 0) {
+            throw new InvalidArgumentException('The fragment cache size can not be negative.');
+        }
+
+        self::$fragmentCacheSize = $size;
+    }
+
+    /**
+     * Get the number of encoded fragments kept by the fragment cache.
+     *
+     * @return int
+     */
+    public static function getFragmentCacheSize() : int
+    {
+        return self::$fragmentCacheSize;
+    }
+
+    /**
+     * Get the scope of the cached decoded values: the cache format, the
+     * registered type handlers and the base64 spill size. Entries of
+     * another scope are never reused.
+     *
+     * @return string
+     */
+    public static function getCacheScope() : string
+    {
+        return static::CACHE_FORMAT . '.' . TypeRegistry::getSignature() . '.' . self::$base64SpillSize;
+    }
+
+    /**
+     * Get the scope of the cached encoded fragments: the cache format and
+     * the registered encoders, the only settings the encoded bytes depend
+     * on. Fragments of another scope are never reused.
+     *
+     * @return string
+     */
+    public static function getFragmentScope() : string
+    {
+        return static::CACHE_FORMAT . '.' . TypeRegistry::getEncoderSignature();
+    }
+}
@@ -0,0 +1,24 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Contract;
+
+/**
+ * An immutable application value whose encoded form can be reused, the key
+ * must change whenever the encoded form would.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Contract
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+interface CacheableValue
+{
+    /**
+     * Get the key of the encoded form, unique within the class.
+     *
+     * @return string
+     */
+    public function getCacheKey() : string;
+}
@@ -0,0 +1,38 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Contract;
+
+/**
+ * Containers used for decoded values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Contract
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+enum OutputMode : string {
+    /**
+     * Structs as Map, lists as Vector.
+     *
+     * @const string
+     */
+    COLLECTION = 'collection';
+
+    /**
+     * Structs as dict, lists as vec.
+     *
+     * @const string
+     */
+    HACK_ARRAY = 'hack_array';
+
+    /**
+     * A param that is an array of structs as Columnar (one column per
+     * member name), any other value, nested arrays of structs included, as
+     * in COLLECTION. Only used by RPC::decode, RPCRequest rejects it.
+     *
+     * @const string
+     */
+    COLUMNAR = 'columnar';
+}
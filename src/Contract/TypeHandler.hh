@@ -0,0 +1,39 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Contract;
+
+use DOMElement;
+use SimpleXMLElement;
+
+/**
+ * Custom encoding and decoding of application values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Contract
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+interface TypeHandler
+{
+    /**
+     * Write the type element of a value (<string>, <struct>...) into its
+     * <value> element.
+     *
+     * @param mixed $value The value to encode.
+     * @param DOMElement $valueElement The empty <value> element.
+     *
+     * @return void
+     */
+    public function encode(mixed $value, DOMElement $valueElement) : void;
+
+    /**
+     * Decode a type node whose tag name is handled by this handler.
+     *
+     * @param SimpleXMLElement $node The type node, ex: <money>.
+     *
+     * @return mixed
+     */
+    public function decode(SimpleXMLElement $node) : mixed;
+}
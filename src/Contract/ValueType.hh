@@ -27,6 +27,20 @@ enum ValueType : string {
      */
     INTEGER = 'int';
 
+    /**
+     * 32 bits integer support type.
+     *
+     * @const string
+     */
+    I4 = 'i4';
+
+    /**
+     * 64 bits integer support type.
+     *
+     * @const string
+     */
+    I8 = 'i8';
+
     /**
      * Float support type.
      *
@@ -47,4 +61,25 @@ enum ValueType : string {
      * @const string
      */
     STRUCT = 'struct';
+
+    /**
+     * Arrays support (lists).
+     *
+     * @const string
+     */
+    ARRAY = 'array';
+
+    /**
+     * Binary data support.
+     *
+     * @const string
+     */
+    BASE64 = 'base64';
+
+    /**
+     * Date and time support.
+     *
+     * @const string
+     */
+    DATETIME = 'dateTime.iso8601';
 }
@@ -0,0 +1,98 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Contract;
+
+/**
+ * Receive the events of a document walk, in document order.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Contract
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+interface Visitor
+{
+    /**
+     * The <methodName> of a request.
+     *
+     * @param string $name
+     *
+     * @return void
+     */
+    public function onMethodName(string $name) : void;
+
+    /**
+     * A top level <param> starts.
+     *
+     * @param int $index The param position.
+     *
+     * @return void
+     */
+    public function onParamStart(int $index) : void;
+
+    /**
+     * The current top level <param> ends.
+     *
+     * @return void
+     */
+    public function onParamEnd() : void;
+
+    /**
+     * A <struct> starts.
+     *
+     * @return void
+     */
+    public function onStructStart() : void;
+
+    /**
+     * A <member> of the current struct starts, its value comes next.
+     *
+     * @param string $name The member name.
+     *
+     * @return void
+     */
+    public function onMember(string $name) : void;
+
+    /**
+     * The current <struct> ends.
+     *
+     * @return void
+     */
+    public function onStructEnd() : void;
+
+    /**
+     * An <array> starts.
+     *
+     * @return void
+     */
+    public function onArrayStart() : void;
+
+    /**
+     * The current <array> ends.
+     *
+     * @return void
+     */
+    public function onArrayEnd() : void;
+
+    /**
+     * A scalar value.
+     *
+     * @param string $type The type tag name, ex: "int".
+     * @param string $text The raw text of the value.
+     *
+     * @return void
+     */
+    public function onScalar(string $type, string $text) : void;
+
+    /**
+     * A value of a type unknown by the library.
+     *
+     * @param string $type The type tag name.
+     * @param string $xml The type node, as XML.
+     *
+     * @return void
+     */
+    public function onCustom(string $type, string $xml) : void;
+}
@@ -0,0 +1,281 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Contract\OutputMode;
+
+/**
+ * APC cache of decoded documents, keyed by a hash of the raw body. The
+ * cached values are returned as immutable containers, so a hit can be
+ * shared without copies.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class DecodeCache
+{
+    /**
+     * The APC keys prefix.
+     *
+     * @var string
+     */
+    const string APC_PREFIX = 'ivyhjk.xml.decode.';
+
+    /**
+     * Default smallest body (in bytes) worth caching, smaller bodies are
+     * parsed faster than they are hashed and fetched.
+     *
+     * @var int
+     */
+    const int DEFAULT_MIN_SIZE = 4096;
+
+    /**
+     * Whether the cache is enabled.
+     *
+     * @var bool
+     */
+    private static bool $enabled = false;
+
+    /**
+     * The smallest cached body, in bytes.
+     *
+     * @var int
+     */
+    private static int $minSize = self::DEFAULT_MIN_SIZE;
+
+    /**
+     * The biggest cached body, in bytes (0 for no limit).
+     *
+     * @var int
+     */
+    private static int $maxSize = 0;
+
+    /**
+     * The entries time to live, in seconds (0 for no expiration).
+     *
+     * @var int
+     */
+    private static int $ttl = 0;
+
+    /**
+     * The lookups found into the cache.
+     *
+     * @var int
+     */
+    private static int $hits = 0;
+
+    /**
+     * The lookups not found into the cache.
+     *
+     * @var int
+     */
+    private static int $misses = 0;
+
+    /**
+     * Cache the decoded bodies into APC.
+     *
+     * @param int $ttl The entries time to live, in seconds (0 for no expiration).
+     * @param int $minSize The smallest cached body, in bytes.
+     * @param int $maxSize The biggest cached body, in bytes (0 for no limit).
+     *
+     * @return void
+     */
+    public static function enable(int $ttl = 0, int $minSize = self::DEFAULT_MIN_SIZE, int $maxSize = 0) : void
+    {
+        self::$enabled = true;
+        self::$ttl = $ttl;
+        self::$minSize = $minSize;
+        self::$maxSize = $maxSize;
+    }
+
+    /**
+     * Stop caching the decoded bodies.
+     *
+     * @return void
+     */
+    public static function disable() : void
+    {
+        self::$enabled = false;
+    }
+
+    /**
+     * Check if a body goes through the cache.
+     *
+     * @param string $xml The raw body.
+     *
+     * @return bool
+     */
+    public static function accepts(string $xml) : bool
+    {
+        if ( ! self::$enabled) {
+            return false;
+        }
+
+        $size = \strlen($xml);
+
+        return $size >= self::$minSize && (self::$maxSize === 0 || $size <= self::$maxSize);
+    }
+
+    /**
+     * Get the cache key of a body. It is scoped by Config::getCacheScope
+     * and the depth limit, so bodies decoded by other type handlers, other
+     * settings or another library version are not reused.
+     *
+     * @param string $xml The raw body.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The decode containers.
+     *
+     * @return string
+     */
+    public static function getKey(string $xml, OutputMode $mode) : string
+    {
+        return \sprintf(
+            '%s%s.%d.%s.%d.%s',
+            self::APC_PREFIX,
+            Config::getCacheScope(),
+            Config::getMaxDepth(),
+            (string) $mode,
+            \strlen($xml),
+            \md5($xml)
+        );
+    }
+
+    /**
+     * Get a decoded body.
+     *
+     * @param string $key The body key.
+     *
+     * @return mixed Null on miss.
+     */
+    public static function fetch(string $key) : mixed
+    {
+        $cached = \apc_fetch($key);
+
+        if ($cached === false) {
+            self::$misses++;
+
+            return null;
+        }
+
+        self::$hits++;
+
+        return $cached;
+    }
+
+    /**
+     * Keep a decoded body.
+     *
+     * @param string $key The body key.
+     * @param mixed $decoded The decoded body.
+     *
+     * @return mixed The value to return to the caller: the immutable version
+     *  of the decoded body, or the body itself when it can not be cached
+     *  (i.e. base64 values spilled into streams).
+     */
+    public static function store(string $key, mixed $decoded) : mixed
+    {
+        list($frozen, $cacheable) = static::freeze($decoded);
+
+        if ( ! $cacheable) {
+            return $decoded;
+        }
+
+        \apc_store($key, $frozen, self::$ttl);
+
+        return $frozen;
+    }
+
+    /**
+     * Get the lookups found into the cache.
+     *
+     * @return int
+     */
+    public static function getHits() : int
+    {
+        return self::$hits;
+    }
+
+    /**
+     * Get the lookups not found into the cache.
+     *
+     * @return int
+     */
+    public static function getMisses() : int
+    {
+        return self::$misses;
+    }
+
+    /**
+     * Reset the counters.
+     *
+     * @return void
+     */
+    public static function resetCounters() : void
+    {
+        self::$hits = 0;
+        self::$misses = 0;
+    }
+
+    /**
+     * Turn the decoded containers into immutable ones.
+     *
+     * @param mixed $value
+     *
+     * @return (mixed, bool) The immutable value and whether it can be cached.
+     */
+    private static function freeze(mixed $value) : (mixed, bool)
+    {
+        if (\is_resource($value)) {
+            return tuple($value, false);
+        }
+
+        if ($value instanceof Map) {
+            $frozen = Map{};
+
+            foreach ($value as $key => $item) {
+                list($item, $cacheable) = static::freeze($item);
+
+                if ( ! $cacheable) {
+                    return tuple($value, false);
+                }
+
+                $frozen->set($key, $item);
+            }
+
+            return tuple($frozen->toImmMap(), true);
+        }
+
+        if ($value instanceof Vector) {
+            $frozen = Vector{};
+            $frozen->reserve($value->count());
+
+            foreach ($value as $item) {
+                list($item, $cacheable) = static::freeze($item);
+
+                if ( ! $cacheable) {
+                    return tuple($value, false);
+                }
+
+                $frozen->add($item);
+            }
+
+            return tuple($frozen->toImmVector(), true);
+        }
+
+        if (is_vec($value) || is_dict($value)) {
+            invariant($value instanceof KeyedTraversable, 'Hack arrays are traversable.');
+
+            // Hack arrays are values already, only their items are checked.
+            foreach ($value as $item) {
+                if ( ! static::freeze($item)[1]) {
+                    return tuple($value, false);
+                }
+            }
+        }
+
+        return tuple($value, true);
+    }
+}
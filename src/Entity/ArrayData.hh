@@ -0,0 +1,236 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Entity;
+
+use DOMElement;
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Caster;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * <array><data> tag concrete class.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Entity
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class ArrayData extends Tag
+{
+    /**
+     * The XML tag name
+     *
+     * @var string
+     */
+    const string TAG_NAME = 'array';
+
+    /**
+     * The XML tag name of the items wrapper.
+     *
+     * @var string
+     */
+    const string DATA_TAG_NAME = 'data';
+
+    /**
+     * Generate a new <array> tag instance.
+     *
+     * @param Vector<Ivyhjk\Xml\Entity\Value> $values The array items.
+     * @param DOMDocument $document The root node.
+     * @param ?string $itemType The scalar type shared by all the items, if any.
+     *
+     * @return void
+     */
+    public function __construct(
+        private Vector<Value> $values,
+        DOMDocument $document,
+        private ?string $itemType = null
+    ) : void
+    {
+        parent::__construct($document);
+    }
+
+    /**
+     * Get the array items.
+     *
+     * @return Vector<Ivyhjk\Xml\Entity\Value>
+     */
+    public function getValues() : Vector<Value>
+    {
+        return $this->values;
+    }
+
+    /**
+     * Get the scalar type shared by all the items, null when the items
+     * are mixed or nested.
+     *
+     * @return ?string
+     */
+    public function getItemType() : ?string
+    {
+        return $this->itemType;
+    }
+
+    /**
+     * Get the <array> tag as a DOMelement.
+     *
+     * @return DOMElement
+     */
+    public function getElement() : DOMElement
+    {
+        $element = $this
+            ->getDocument()
+            ->createElement(static::TAG_NAME);
+
+        $dataElement = $this
+            ->getDocument()
+            ->createElement(static::DATA_TAG_NAME);
+
+        foreach ($this->getValues() as $value) {
+            $dataElement->appendChild($value->getElement());
+        }
+
+        $element->appendChild($dataElement);
+
+        return $element;
+    }
+
+    /**
+     * Get the <value> nodes of an <array> node.
+     *
+     * @param SimpleXMLElement $node The <array> node.
+     *
+     * @return array<SimpleXMLElement>
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    public static function getValueNodes(SimpleXMLElement $node) : array<SimpleXMLElement>
+    {
+        if ($node->getName() !== static::TAG_NAME) {
+            throw new InvalidNodeException(\sprintf(
+                'Invalid tag name for "%s".',
+                static::TAG_NAME
+            ));
+        }
+
+        $dataNode = (new Vector($node->xpath(static::DATA_TAG_NAME)))->firstValue();
+
+        if ($dataNode === null) {
+            throw new InvalidNodeException(\sprintf(
+                'Tag "%s" not found into "%s" node.',
+                static::DATA_TAG_NAME,
+                static::TAG_NAME
+            ));
+        }
+
+        return $dataNode->xpath(Value::TAG_NAME);
+    }
+
+    /**
+     * Generate a new ArrayData out of the items of an <array> node when all
+     * of them hold a single type node of the same scalar type: the items
+     * are cast in place, without walking their <value> nodes.
+     *
+     * @param array<SimpleXMLElement> $valueNodes The <value> items.
+     * @param DOMDocument $document
+     *
+     * @return ?Ivyhjk\Xml\Entity\ArrayData Null when the items are mixed, nested or malformed.
+     */
+    public static function fromScalarNodes(array<SimpleXMLElement> $valueNodes, DOMDocument $document) : ?ArrayData
+    {
+        $scalarNodes = static::getScalarNodes($valueNodes);
+
+        if ($scalarNodes === null) {
+            return null;
+        }
+
+        $itemType = $scalarNodes[0]->getName();
+        $caster = Caster::getCaster($itemType);
+
+        $items = Vector{};
+        $items->reserve(\count($scalarNodes));
+
+        foreach ($scalarNodes as $scalarNode) {
+            $items->add(new Value(Vector{$caster($scalarNode)}, $document));
+        }
+
+        return new ArrayData($items, $document, $itemType);
+    }
+
+    /**
+     * Get the type nodes (<int>, <string>...) of the items of an <array>
+     * node when each item holds exactly one, all of the same scalar type.
+     *
+     * @param array<SimpleXMLElement> $valueNodes The <value> items.
+     *
+     * @return ?array<SimpleXMLElement> Null when the items are mixed, nested or malformed.
+     */
+    private static function getScalarNodes(array<SimpleXMLElement> $valueNodes) : ?array<SimpleXMLElement>
+    {
+        $typedNodes = [];
+        $type = null;
+
+        foreach ($valueNodes as $valueNode) {
+            $typedNode = null;
+
+            foreach ($valueNode->children() as $child) {
+                // Several type tags into a single item.
+                if ($typedNode !== null) {
+                    return null;
+                }
+
+                $typedNode = $child;
+            }
+
+            if ($typedNode === null) {
+                return null;
+            }
+
+            $name = $typedNode->getName();
+
+            if ($type === null) {
+                if ($name === Struct::TAG_NAME || $name === static::TAG_NAME) {
+                    return null;
+                }
+
+                $type = $name;
+            } else if ($name !== $type) {
+                return null;
+            }
+
+            $typedNodes[] = $typedNode;
+        }
+
+        return $type === null ? null : $typedNodes;
+    }
+
+    /**
+     * Generate a new ArrayData from a given SimpleXMLElement $node.
+     *
+     * @param SimpleXMLElement $node
+     * @param DOMDocument $document
+     *
+     * @return Ivyhjk\Xml\Entity\ArrayData
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    public static function fromNode(SimpleXMLElement $node, DOMDocument $document) : ArrayData
+    {
+        $valueNodes = static::getValueNodes($node);
+
+        $scalars = static::fromScalarNodes($valueNodes, $document);
+
+        if ($scalars !== null) {
+            return $scalars;
+        }
+
+        $valueEntities = Vector{};
+        $valueEntities->reserve(\count($valueNodes));
+
+        foreach ($valueNodes as $valueNode) {
+            $valueEntities->add(Value::fromNode($valueNode, $document));
+        }
+
+        return new ArrayData($valueEntities, $document);
+    }
+}
@@ -86,6 +86,23 @@ class Member extends Tag
      * @return Ivyhjk\Xml\Entity\Member
      */
     public static function fromNode(SimpleXMLElement $node, DOMDocument $document) : Member
+    {
+        list($memberName, $valueNode) = static::parseNode($node);
+
+        $valueEntity = Value::fromNode($valueNode, $document);
+
+        return new Member($memberName, $valueEntity, $document);
+    }
+
+    /**
+     * Split a <member> node into its name and its <value> node.
+     *
+     * @param SimpleXMLElement $node
+     *
+     * @return (string, SimpleXMLElement)
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    public static function parseNode(SimpleXMLElement $node) : (string, SimpleXMLElement)
     {
         if ($node->getName() !== static::TAG_NAME) {
             throw new InvalidNodeException(\sprintf(
@@ -113,9 +130,6 @@ class Member extends Tag
             ));
         }
 
-        $memberName = (string) $nameNode;
-        $valueEntity = Value::fromNode($valueNode, $document);
-
-        return new Member($memberName, $valueEntity, $document);
+        return tuple((string) $nameNode, $valueNode);
     }
 }
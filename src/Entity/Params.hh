@@ -94,4 +94,56 @@ class Params extends Tag
 
         return  new Params($paramEntities, $document);
     }
+
+    /**
+     * Check if native parameters are spread into one <param> per item: a
+     * vec, a keyset or a PHP list are, anything else is a single <param>.
+     *
+     * @param mixed $parameters RPC method args.
+     *
+     * @return bool
+     */
+    public static function isSpread(mixed $parameters) : bool
+    {
+        if (is_vec($parameters) || is_keyset($parameters)) {
+            return true;
+        }
+
+        if (is_dict($parameters)) {
+            return false;
+        }
+
+        return is_array($parameters) && \array_key_exists(0, $parameters);
+    }
+
+    /**
+     * Generate a new Params instance from native values.
+     *
+     * A vec (or a PHP list) is spread into one <param> per item, anything
+     * else is sent as a single <param>.
+     *
+     * @param mixed $parameters RPC method args.
+     * @param DOMDocument $document The root node.
+     *
+     * @return Ivyhjk\Xml\Entity\Params
+     */
+    public static function fromValue(mixed $parameters, DOMDocument $document) : Params
+    {
+        if ( ! static::isSpread($parameters)) {
+            $parameters = Vector{$parameters};
+        }
+
+        $givenParams = Vector{};
+
+        invariant($parameters instanceof Traversable, 'A list of parameters was expected.');
+
+        foreach ($parameters as $parameter) {
+            $value = new Value(Vector{$parameter}, $document);
+            $param = new Param(Vector{$value}, $document);
+
+            $givenParams->add($param);
+        }
+
+        return new Params($givenParams, $document);
+    }
 }
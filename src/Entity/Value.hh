@@ -5,10 +5,24 @@ namespace Ivyhjk\Xml\Entity;
 use DOMElement;
 use DOMDocument;
 use SimpleXMLElement;
+use DateTimeInterface;
 use Ivyhjk\Xml\Caster;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Number;
+use Ivyhjk\Xml\FragmentCache;
+use Ivyhjk\Xml\TypeRegistry;
 use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Metadata\MetadataCache;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Type\Placeholder;
+use Ivyhjk\Xml\Type\PlaceholderHandler;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
 use Ivyhjk\Xml\Exception\InvalidNodeException;
 use Ivyhjk\Xml\Exception\UnsupportedValueType;
+use Ivyhjk\Xml\Exception\XmlException;
 
 /**
  * <methodName> tag concrete class.
@@ -29,6 +43,25 @@ class Value extends Tag
      */
     const string TAG_NAME = 'value';
 
+    /**
+     * parseValue instructions: parse a Value entity, parse one of its
+     * children, and pop the parsed children into a struct or a list
+     * (used for <array> and for <value> tags with many children).
+     *
+     * @var int
+     */
+    const int PARSE_VALUE = 0;
+    const int PARSE_ITEM = 1;
+    const int BUILD_STRUCT = 2;
+    const int BUILD_LIST = 3;
+
+    /**
+     * The fragment cache keys prefix of the DOM encoded values.
+     *
+     * @var string
+     */
+    const string FRAGMENT_PREFIX = 'dom.';
+
     /**
      * Generate a new <value> tag instance.
      *
@@ -58,7 +91,11 @@ class Value extends Tag
     /**
      * Get the <methodCall> tag as a DOMelement.
      *
+     * Nested values are walked with an explicit stack instead of recursing
+     * through Struct and Member, so the depth is only bound by Config.
+     *
      * @return DOMElement
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
      */
     public function getElement() : DOMElement
     {
@@ -66,110 +103,677 @@ class Value extends Tag
             ->getDocument()
             ->createElement(static::TAG_NAME);
 
-        // Create the element with anything.
-        foreach ($this->getValues() as $value) {
-            if ($value instanceof Struct) {
-                $typeElement = $value->getElement();
+        $stack = Vector{};
+
+        static::pushValues($stack, $valueElement, $this->getValues(), 1);
+
+        while ( ! $stack->isEmpty()) {
+            list($element, $value, $depth) = $stack->pop();
+
+            $this->appendValue($element, $value, $depth, $stack);
+        }
+
+        return $valueElement;
+    }
+
+    /**
+     * Append the type element of a single value into a <value> element,
+     * pending nested values are pushed into the given stack.
+     *
+     * @param DOMElement $valueElement The <value> element to fill.
+     * @param mixed $value The value to encode.
+     * @param int $depth The nesting level of the <value> element.
+     * @param Vector<(DOMElement, mixed, int)> $stack The pending values.
+     * @param bool $cacheable Whether the fragment cache may be used.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    private function appendValue(
+        DOMElement $valueElement,
+        mixed $value,
+        int $depth,
+        Vector<(DOMElement, mixed, int)> $stack,
+        bool $cacheable = true
+    ) : void
+    {
+        $document = $this->getDocument();
+
+        if ($depth > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        if ($cacheable && FragmentCache::isEnabled()) {
+            $key = FragmentCache::getKey($value);
+
+            if ($key !== null) {
+                $this->appendCached($valueElement, $value, $depth, static::FRAGMENT_PREFIX . $key);
+
+                return;
+            }
+        }
+
+        if ($value instanceof Struct) {
+            $typeElement = $document->createElement(Struct::TAG_NAME);
+
+            foreach ($value->getMembers() as $member) {
+                $childElement = $this->appendMember($typeElement, $member->getName());
+
+                static::pushValues($stack, $childElement, $member->getValue()->getValues(), $depth + 1);
+            }
+
+            $valueElement->appendChild($typeElement);
+
+            return;
+        }
+
+        if ($value instanceof ArrayData) {
+            $dataElement = $this->appendArray($valueElement);
+
+            foreach ($value->getValues() as $item) {
+                $childElement = $document->createElement(static::TAG_NAME);
+                $dataElement->appendChild($childElement);
+
+                static::pushValues($stack, $childElement, $item->getValues(), $depth + 1);
+            }
+
+            return;
+        }
+
+        // Template slots, marked for RequestTemplate::prepare.
+        if ($value instanceof Placeholder) {
+            (new PlaceholderHandler())->encode($value, $valueElement);
+
+            return;
+        }
+
+        // Application objects with a registered handler.
+        $handler = TypeRegistry::getEncoder($value);
+
+        if ($handler !== null) {
+            $handler->encode($value, $valueElement);
+
+            return;
+        }
+
+        if ($value instanceof TypedList || static::isList($value)) {
+            if ($value instanceof TypedList) {
+                $items = $value->getItems();
+                $itemType = $value->getType();
             } else {
-                $type = \gettype($value);
+                invariant($value instanceof Traversable, 'A list was expected.');
+
+                $items = $value;
+                $itemType = static::getItemType($value);
+            }
 
-                if ($type === 'integer') {
-                    $type = 'int';
-                } else if ($type === 'object' || $type === 'array') {
-                    $type = 'struct';
+            $dataElement = $this->appendArray($valueElement);
+
+            if ($itemType === ValueType::STRUCT) {
+                $this->appendStructs($dataElement, $items, $depth + 1, $stack);
+            } else if ($itemType !== null && $itemType !== ValueType::ARRAY) {
+                if ($depth + 1 > Config::getMaxDepth()) {
+                    throw new DepthLimitExceeded(Config::getMaxDepth());
                 }
 
-                try {
-                    ValueType::assert($type);
-                } catch (\UnexpectedValueException $e) {
-                    throw new UnsupportedValueType($type);
+                $this->appendScalars($dataElement, $items, $itemType);
+            } else {
+                foreach ($items as $item) {
+                    $childElement = $document->createElement(static::TAG_NAME);
+                    $dataElement->appendChild($childElement);
+
+                    $stack->add(tuple($childElement, $item, $depth + 1));
                 }
+            }
+
+            return;
+        }
+
+        // Dates keep their original text, native dates are formatted.
+        if ($value instanceof Timestamp || $value instanceof DateTimeInterface) {
+            $timestamp = $value instanceof Timestamp ? $value : Timestamp::fromDateTime($value);
+
+            $valueElement->appendChild($document->createElement(
+                Timestamp::TAG_NAME,
+                $timestamp->getLexeme()
+            ));
+
+            return;
+        }
+
+        // Binary data, streams are read chunk by chunk. The DOM still holds
+        // the whole encoded text, only Writer streams it into the output.
+        if ($value instanceof Base64 || (\is_resource($value) && \get_resource_type($value) === 'stream')) {
+            $base64 = $value instanceof Base64 ? $value : Base64::fromStream($value);
+
+            $typeElement = $document->createElement('base64');
+
+            foreach ($base64->encode() as $chunk) {
+                $typeElement->appendChild($document->createTextNode($chunk));
+            }
 
-                if ($type === 'struct') {
-                    $typeElement = null;
+            $valueElement->appendChild($typeElement);
+
+            return;
+        }
+
+        $type = is_dict($value) ? 'struct' : \gettype($value);
+
+        if ($type === 'integer') {
+            $type = 'int';
+        } else if ($type === 'object' || $type === 'array') {
+            $type = 'struct';
+        }
+
+        try {
+            ValueType::assert($type);
+        } catch (\UnexpectedValueException $e) {
+            throw new UnsupportedValueType($type);
+        }
+
+        if ($type === 'struct' && ! $value instanceof KeyedTraversable) {
+            if ( ! \is_object($value) || $value instanceof \Closure) {
+                throw new UnsupportedValueType(\gettype($value));
+            }
 
-                    if ( ! $value instanceof KeyedTraversable) {
-                        throw new UnsupportedValueType(\gettype($value));
+            // Plain objects: the public properties, described once per class.
+            $metadata = MetadataCache::get(\get_class($value));
+            $properties = \get_object_vars($value);
+
+            $typeElement = $document->createElement(Struct::TAG_NAME);
+
+            foreach ($metadata->getNames() as $memberName) {
+                // Unset properties, and null as XML RPC has no null.
+                if (($properties[$memberName] ?? null) === null) {
+                    continue;
+                }
+
+                $childElement = $this->appendMember($typeElement, $memberName);
+
+                $stack->add(tuple($childElement, $properties[$memberName], $depth + 1));
+            }
+        } else if ($type === 'struct') {
+            invariant($value instanceof KeyedTraversable, 'A struct was expected.');
+
+            $typeElement = $document->createElement(Struct::TAG_NAME);
+
+            foreach ($value as $memberName => $memberValue) {
+                $childElement = $this->appendMember($typeElement, (string) $memberName);
+
+                $stack->add(tuple($childElement, $memberValue, $depth + 1));
+            }
+        } else if ($type === 'double') {
+            $typeElement = $document->createElement($type, Number::formatDouble((float) $value));
+        } else {
+            // If is not struct always contain an string as value.
+            $typeElement = $document->createElement($type, (string) $value);
+        }
+
+        $valueElement->appendChild($typeElement);
+    }
+
+    /**
+     * Append the items of a homogeneous scalar list, the type is resolved
+     * once for the whole list.
+     *
+     * @param DOMElement $dataElement The <data> element.
+     * @param Traversable<mixed> $items The list items.
+     * @param Ivyhjk\Xml\Contract\ValueType $itemType The type of every item.
+     *
+     * @return void
+     */
+    private function appendScalars(DOMElement $dataElement, Traversable<mixed> $items, ValueType $itemType) : void
+    {
+        $document = $this->getDocument();
+
+        $isDouble = $itemType === ValueType::FLOAT || $itemType === ValueType::DOUBLE;
+        $type = $isDouble ? 'double' : (string) $itemType;
+
+        foreach ($items as $item) {
+            $text = TypedList::toText($itemType, $item);
+
+            $childElement = $document->createElement(static::TAG_NAME);
+            $childElement->appendChild($document->createElement($type, $text));
+
+            $dataElement->appendChild($childElement);
+        }
+    }
+
+    /**
+     * Append the items of a list of structs with the same members, the
+     * <member><name> elements are built once and cloned for every item.
+     *
+     * @param DOMElement $dataElement The <data> element.
+     * @param Traversable<mixed> $items The list items.
+     * @param int $depth The nesting level of the items <value> elements.
+     * @param Vector<(DOMElement, mixed, int)> $stack The pending values.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function appendStructs(
+        DOMElement $dataElement,
+        Traversable<mixed> $items,
+        int $depth,
+        Vector<(DOMElement, mixed, int)> $stack
+    ) : void
+    {
+        $document = $this->getDocument();
+
+        if ($depth + 1 > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        $names = null;
+        $templates = Vector{};
+
+        foreach ($items as $item) {
+            if ( ! $item instanceof KeyedTraversable) {
+                throw new UnsupportedValueType(\gettype($item));
+            }
+
+            $childElement = $document->createElement(static::TAG_NAME);
+            $structElement = $document->createElement(Struct::TAG_NAME);
+
+            $childElement->appendChild($structElement);
+            $dataElement->appendChild($childElement);
+
+            // The first item defines the layout.
+            if ($names === null) {
+                $names = Vector{};
+
+                foreach ($item as $memberName => $memberValue) {
+                    $names->add((string) $memberName);
+                    $templates->add($this->createMember((string) $memberName));
+                }
+            }
+
+            $index = 0;
+
+            foreach ($item as $memberName => $memberValue) {
+                if ($index >= $names->count() || (string) $memberName !== $names->at($index)) {
+                    throw new XmlException('All the structs of the list must have the same members.');
+                }
+
+                $memberElement = $templates->at($index)->cloneNode(true);
+                $structElement->appendChild($memberElement);
+
+                $memberValueElement = $memberElement->lastChild;
+
+                invariant($memberValueElement instanceof DOMElement, 'A <value> element was expected.');
+
+                $stack->add(tuple($memberValueElement, $memberValue, $depth + 1));
+
+                $index++;
+            }
+
+            if ($index !== $names->count()) {
+                throw new XmlException('All the structs of the list must have the same members.');
+            }
+        }
+    }
+
+    /**
+     * Get the type shared by all the items of a list: a scalar type, or
+     * struct when all the items have the same keys in the same order.
+     *
+     * @param Traversable<mixed> $items The list items.
+     *
+     * @return ?Ivyhjk\Xml\Contract\ValueType Null for mixed lists.
+     */
+    private static function getItemType(Traversable<mixed> $items) : ?ValueType
+    {
+        $itemType = null;
+        $names = Vector{};
+
+        foreach ($items as $item) {
+            if (is_int($item)) {
+                $type = ValueType::INTEGER;
+            } else if (is_float($item)) {
+                $type = ValueType::DOUBLE;
+            } else if (is_string($item)) {
+                $type = ValueType::STRING;
+            } else if (is_dict($item) || $item instanceof ConstMap || (is_array($item) && ! static::isList($item))) {
+                $type = ValueType::STRUCT;
+            } else {
+                return null;
+            }
+
+            if ($itemType === null) {
+                $itemType = $type;
+
+                if ($type === ValueType::STRUCT) {
+                    invariant($item instanceof KeyedTraversable, 'A struct was expected.');
+
+                    foreach ($item as $memberName => $memberValue) {
+                        $names->add($memberName);
                     }
+                }
 
-                    $members = Vector{};
+                continue;
+            }
+
+            if ($type !== $itemType) {
+                return null;
+            }
+
+            if ($type === ValueType::STRUCT) {
+                invariant($item instanceof KeyedTraversable, 'A struct was expected.');
 
-                    foreach ($value as $memberName => $memberValue) {
-                        $childValue = new Value(Vector{
-                            $memberValue
-                        }, $this->getDocument());
+                $index = 0;
 
-                        $member = new Member($memberName, $childValue, $this->getDocument());
-                        $members->add($member);
+                foreach ($item as $memberName => $memberValue) {
+                    if ($index >= $names->count() || $memberName !== $names->at($index)) {
+                        return null;
                     }
 
-                    $struct = new Struct($members, $this->getDocument());
+                    $index++;
+                }
 
-                    $typeElement = $struct->getElement();
-                } else {
-                    // If is not struct always contain an string as value.
-                    $typeElement = $this->getDocument()->createElement($type, (string) $value);
+                if ($index !== $names->count()) {
+                    return null;
                 }
             }
+        }
 
-            $valueElement->appendChild($typeElement);
+        return $itemType;
+    }
+
+    /**
+     * Check if a native value is sent as an <array>: Hack vec and keyset,
+     * vectors, and PHP arrays with sequential keys starting at 0.
+     *
+     * @param mixed $value The value to check.
+     *
+     * @return bool
+     */
+    public static function isList(mixed $value) : bool
+    {
+        if (is_vec($value) || is_keyset($value) || $value instanceof ConstVector) {
+            return true;
         }
 
-        return $valueElement;
+        if (is_dict($value) || ! is_array($value) || \count($value) === 0) {
+            return false;
+        }
+
+        $index = 0;
+
+        foreach ($value as $key => $item) {
+            if ($key !== $index) {
+                return false;
+            }
+
+            $index++;
+        }
+
+        return true;
     }
 
-    public static function fromNode(SimpleXMLElement $node, DOMDocument $document) : Value
+    /**
+     * Append an <array><data> into a <value> element.
+     *
+     * @param DOMElement $valueElement The <value> element.
+     *
+     * @return DOMElement The empty <data> element.
+     */
+    private function appendArray(DOMElement $valueElement) : DOMElement
     {
-        // Name is mandatory!.
-        if ($node->getName() !== self::TAG_NAME) {
-            throw new InvalidNodeException(\sprintf(
-                'Invalid tag name for "%s".',
-                static::TAG_NAME
-            ));
+        $document = $this->getDocument();
+
+        $arrayElement = $document->createElement(ArrayData::TAG_NAME);
+        $dataElement = $document->createElement(ArrayData::DATA_TAG_NAME);
+
+        $arrayElement->appendChild($dataElement);
+        $valueElement->appendChild($arrayElement);
+
+        return $dataElement;
+    }
+
+    /**
+     * Append the type element of a cacheable value from the fragment cache,
+     * or encode it whole and keep it there.
+     *
+     * @param DOMElement $valueElement The <value> element to fill.
+     * @param mixed $value The value to encode.
+     * @param int $depth The nesting level of the <value> element.
+     * @param string $key The fragment cache key.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    private function appendCached(DOMElement $valueElement, mixed $value, int $depth, string $key) : void
+    {
+        $document = $this->getDocument();
+        $entry = FragmentCache::get($key);
+
+        if ($entry !== null) {
+            list($fragment, $height) = $entry;
+
+            // The fragment may have been encoded at a shallower level.
+            if ($depth + $height > Config::getMaxDepth()) {
+                throw new DepthLimitExceeded(Config::getMaxDepth());
+            }
+
+            $nodes = $document->createDocumentFragment();
+            $nodes->appendXML($fragment);
+
+            $valueElement->appendChild($nodes);
+
+            return;
+        }
+
+        $element = $document->createElement(static::TAG_NAME);
+        $stack = Vector{};
+
+        $this->appendValue($element, $value, $depth, $stack, false);
+
+        // Only the outermost cacheable value is looked up.
+        while ( ! $stack->isEmpty()) {
+            list($childElement, $childValue, $childDepth) = $stack->pop();
+
+            $this->appendValue($childElement, $childValue, $childDepth, $stack, false);
+        }
+
+        $fragment = '';
+
+        foreach ($element->childNodes as $child) {
+            $fragment .= $document->saveXML($child);
+        }
+
+        FragmentCache::set($key, $fragment, FragmentCache::measure($fragment));
+
+        while ($element->firstChild !== null) {
+            $valueElement->appendChild($element->firstChild);
         }
+    }
+
+    /**
+     * Append a <member> with its <name> into a <struct> element.
+     *
+     * @param DOMElement $structElement The <struct> element.
+     * @param string $name The member name.
+     *
+     * @return DOMElement The empty <value> element of the new member.
+     */
+    private function appendMember(DOMElement $structElement, string $name) : DOMElement
+    {
+        $memberElement = $this->createMember($name);
+
+        $structElement->appendChild($memberElement);
+
+        $childElement = $memberElement->lastChild;
+
+        invariant($childElement instanceof DOMElement, 'A <value> element was expected.');
+
+        return $childElement;
+    }
+
+    /**
+     * Create a <member> element with its <name> and an empty <value>.
+     *
+     * @param string $name The member name.
+     *
+     * @return DOMElement
+     */
+    private function createMember(string $name) : DOMElement
+    {
+        $document = $this->getDocument();
+
+        $memberElement = $document->createElement(Member::TAG_NAME);
 
-        $children = $node->children();
+        $memberElement->appendChild($document->createElement('name', $name));
+        $memberElement->appendChild($document->createElement(static::TAG_NAME));
 
-        if ($children->count() < 1) {
-            throw new InvalidNodeException('Value tag has no children.');
+        return $memberElement;
+    }
+
+    /**
+     * Push the values of a <value> element into the pending stack.
+     *
+     * The values are pushed backwards, so they are popped (and appended)
+     * in the original order.
+     *
+     * @param Vector<(DOMElement, mixed, int)> $stack The pending values.
+     * @param DOMElement $element The <value> element.
+     * @param Vector<mixed> $values The values to be pushed.
+     * @param int $depth The nesting level of the <value> element.
+     *
+     * @return void
+     */
+    private static function pushValues(
+        Vector<(DOMElement, mixed, int)> $stack,
+        DOMElement $element,
+        Vector<mixed> $values,
+        int $depth
+    ) : void
+    {
+        for ($i = $values->count() - 1; $i >= 0; $i--) {
+            $stack->add(tuple($element, $values->at($i), $depth));
         }
+    }
+
+    /**
+     * Generate a new Value from a given SimpleXMLElement $node.
+     *
+     * The nested <struct> and <member> nodes are walked with an explicit
+     * stack, the entities are created first and filled when popped.
+     *
+     * @param SimpleXMLElement $node
+     * @param DOMDocument $document
+     * @param int $depth The nesting level of the node, for nodes read out of
+     *  a bigger document.
+     *
+     * @return Ivyhjk\Xml\Entity\Value
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    public static function fromNode(SimpleXMLElement $node, DOMDocument $document, int $depth = 1) : Value
+    {
+        $maxDepth = Config::getMaxDepth();
 
         $values = Vector{};
+        $stack = Vector{tuple($node, $values, $depth)};
 
-        foreach ($children as $child) {
-            $childName = $child->getName();
+        while ( ! $stack->isEmpty()) {
+            list($valueNode, $valueValues, $depth) = $stack->pop();
 
-            if ($childName === Struct::TAG_NAME) {
-                $casted = null;
+            if ($depth > $maxDepth) {
+                throw new DepthLimitExceeded($maxDepth);
+            }
 
-                $struct = Struct::fromNode($child, $document);
+            // Name is mandatory!.
+            if ($valueNode->getName() !== self::TAG_NAME) {
+                throw new InvalidNodeException(\sprintf(
+                    'Invalid tag name for "%s".',
+                    static::TAG_NAME
+                ));
+            }
 
-                $values->add($struct);
-            } else {
-                $casted = Caster::cast($child->getName(), $child);
+            $children = $valueNode->children();
 
-                $values->add($casted);
+            if ($children->count() < 1) {
+                throw new InvalidNodeException('Value tag has no children.');
             }
-        }
 
-        $value = new Value($values, $document);
+            foreach ($children as $child) {
+                $childName = $child->getName();
+
+                if ($childName === Struct::TAG_NAME) {
+                    $members = Vector{};
+
+                    foreach ($child->xpath(Member::TAG_NAME) as $memberNode) {
+                        list($memberName, $memberValueNode) = Member::parseNode($memberNode);
+
+                        $memberValues = Vector{};
+
+                        $members->add(new Member(
+                            $memberName,
+                            new Value($memberValues, $document),
+                            $document
+                        ));
+
+                        $stack->add(tuple($memberValueNode, $memberValues, $depth + 1));
+                    }
+
+                    $valueValues->add(new Struct($members, $document));
+                } else if ($childName === ArrayData::TAG_NAME) {
+                    $itemNodes = ArrayData::getValueNodes($child);
+
+                    // Same scalar type for every item: cast them in place.
+                    $scalars = ArrayData::fromScalarNodes($itemNodes, $document);
+
+                    if ($scalars !== null) {
+                        if ($depth + 1 > $maxDepth) {
+                            throw new DepthLimitExceeded($maxDepth);
+                        }
+
+                        $valueValues->add($scalars);
 
-        return $value;
+                        continue;
+                    }
+
+                    $items = Vector{};
+                    $items->reserve(\count($itemNodes));
+
+                    foreach ($itemNodes as $itemNode) {
+                        $itemValues = Vector{};
+
+                        $items->add(new Value($itemValues, $document));
+
+                        $stack->add(tuple($itemNode, $itemValues, $depth + 1));
+                    }
+
+                    $valueValues->add(new ArrayData($items, $document));
+                } else {
+                    $casted = Caster::cast($childName, $child);
+
+                    $valueValues->add($casted);
+                }
+            }
+        }
+
+        return new Value($values, $document);
     }
 
     /**
      * Parse a vector of Value into readable values.
      *
      * @param Vector<Ivyhjk\Xml\Entity\Value> $values The values to be parsed.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
      *
      * @return Vector<mixed>
      */
-    public static function parseValues(Vector<Value> $values) : Vector<mixed>
+    public static function parseValues(
+        Vector<Value> $values,
+        OutputMode $mode = OutputMode::COLLECTION
+    ) : Vector<mixed>
     {
         $parsedValues = Vector{};
 
         foreach ($values as $value) {
-            $parsed = self::parseValue($value);
+            $parsed = self::parseValue($value, $mode);
 
             $parsedValues->add($parsed);
         }
@@ -180,39 +784,166 @@ class Value extends Tag
     /**
      * Parse a Value objecto into a readable value.
      *
+     * The tree is walked with an explicit stack in post-order: children are
+     * parsed first into $results, then the BUILD_* instructions pop them
+     * into their container. This works for Map and for dict alike.
+     *
      * @param Ivyhjk\Xml\Entity\Value $value The value to be parsed.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
      *
      * @return mixed
      */
-    public static function parseValue(Value $value) : mixed
+    public static function parseValue(Value $value, OutputMode $mode = OutputMode::COLLECTION) : mixed
     {
-        $parsedValues = Vector{};
-        $childrenValues = $value->getValues();
+        $results = Vector{};
+        $stack = Vector{};
 
-        foreach ($childrenValues as $childValue) {
-            if ($childValue instanceof Struct) {
-                // Struct are objects, objects are KeyedTraversable.
-                $parsedStruct = Map{};
+        $stack->add(tuple(self::PARSE_VALUE, $value));
 
-                $members = $childValue->getMembers();
+        while ( ! $stack->isEmpty()) {
+            list($instruction, $operand) = $stack->pop();
 
-                foreach ($members as $member) {
-                    $memberKey = $member->getName();
-                    $parsedValue = self::parseValue($member->getValue());
+            switch ($instruction) {
+                case self::PARSE_VALUE:
+                    invariant($operand instanceof Value, 'A value entity was expected.');
 
-                    $parsedStruct->set($memberKey, $parsedValue);
-                }
+                    $children = $operand->getValues();
 
-                $parsedValues->add($parsedStruct);
-            } else {
-                $parsedValues->add($childValue);
+                    // A single child is the value itself, many are a list.
+                    if ($children->count() !== 1) {
+                        $stack->add(tuple(self::BUILD_LIST, $children->count()));
+                    }
+
+                    for ($i = $children->count() - 1; $i >= 0; $i--) {
+                        $stack->add(tuple(self::PARSE_ITEM, $children->at($i)));
+                    }
+                    break;
+                case self::PARSE_ITEM:
+                    if ($operand instanceof Struct) {
+                        $members = $operand->getMembers();
+
+                        $stack->add(tuple(self::BUILD_STRUCT, $operand));
+
+                        for ($i = $members->count() - 1; $i >= 0; $i--) {
+                            $stack->add(tuple(self::PARSE_VALUE, $members->at($i)->getValue()));
+                        }
+                    } else if ($operand instanceof ArrayData) {
+                        $items = $operand->getValues();
+
+                        if ($operand->getItemType() !== null) {
+                            // Scalar items only: no instruction per item.
+                            $results->add(static::parseScalars($items, $mode));
+
+                            break;
+                        }
+
+                        $stack->add(tuple(self::BUILD_LIST, $items->count()));
+
+                        for ($i = $items->count() - 1; $i >= 0; $i--) {
+                            $stack->add(tuple(self::PARSE_VALUE, $items->at($i)));
+                        }
+                    } else {
+                        $results->add($operand);
+                    }
+                    break;
+                case self::BUILD_STRUCT:
+                    invariant($operand instanceof Struct, 'A struct entity was expected.');
+
+                    $members = $operand->getMembers();
+                    $offset = $results->count() - $members->count();
+
+                    if ($mode === OutputMode::HACK_ARRAY) {
+                        $parsedStruct = dict[];
+
+                        foreach ($members as $i => $member) {
+                            $parsedStruct[$member->getName()] = $results->at($offset + $i);
+                        }
+                    } else {
+                        // Struct are objects, objects are KeyedTraversable.
+                        $parsedStruct = Map{};
+
+                        foreach ($members as $i => $member) {
+                            $parsedStruct->set($member->getName(), $results->at($offset + $i));
+                        }
+                    }
+
+                    $results->resize($offset, null);
+                    $results->add($parsedStruct);
+                    break;
+                case self::BUILD_LIST:
+                    invariant(is_int($operand), 'A list size was expected.');
+
+                    $offset = $results->count() - $operand;
+
+                    if ($mode === OutputMode::HACK_ARRAY) {
+                        $parsedValues = vec[];
+
+                        for ($i = $offset; $i < $results->count(); $i++) {
+                            $parsedValues[] = $results->at($i);
+                        }
+                    } else {
+                        // The size is known, allocate the packed storage once.
+                        $parsedValues = Vector{};
+                        $parsedValues->reserve($operand);
+
+                        for ($i = $offset; $i < $results->count(); $i++) {
+                            $parsedValues->add($results->at($i));
+                        }
+                    }
+
+                    $results->resize($offset, null);
+                    $results->add($parsedValues);
+                    break;
+            }
+        }
+
+        return $results->firstValue();
+    }
+
+    /**
+     * Parse the items of a homogeneous scalar <array>.
+     *
+     * @param Vector<Ivyhjk\Xml\Entity\Value> $items The array items.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return mixed
+     */
+    private static function parseScalars(Vector<Value> $items, OutputMode $mode) : mixed
+    {
+        if ($mode === OutputMode::HACK_ARRAY) {
+            $parsedValues = vec[];
+
+            foreach ($items as $item) {
+                $parsedValues[] = $item->getValues()->at(0);
             }
+
+            return $parsedValues;
         }
 
-        if ($parsedValues->count() === 1) {
-            return $parsedValues->firstValue();
+        $parsedValues = Vector{};
+        $parsedValues->reserve($items->count());
+
+        foreach ($items as $item) {
+            $parsedValues->add($item->getValues()->at(0));
         }
 
         return $parsedValues;
     }
+
+    /**
+     * Convert a list of parsed values into the container of the given mode.
+     *
+     * @param Vector<mixed> $values The parsed values.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return mixed
+     */
+    public static function toList(Vector<mixed> $values, OutputMode $mode) : mixed
+    {
+        if ($mode === OutputMode::HACK_ARRAY) {
+            return vec($values);
+        }
+
+        return $values;
+    }
 }
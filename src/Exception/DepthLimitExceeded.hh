@@ -0,0 +1,30 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Exception;
+
+/**
+ * Handle values nested deeper than the configured limit.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Exception
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class DepthLimitExceeded extends XmlException
+{
+    /**
+     * Generate the new exception for too deep values.
+     *
+     * @param int $limit The configured depth limit.
+     *
+     * @return void
+     */
+    public function __construct(int $limit) : void
+    {
+        $message = \sprintf('Maximum nesting depth of %d exceeded.', $limit);
+
+        parent::__construct($message);
+    }
+}
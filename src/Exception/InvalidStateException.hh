@@ -0,0 +1,18 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Exception;
+
+/**
+ * Handle calls made in the wrong order, ex: writer events out of place.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Exception
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class InvalidStateException extends XmlException
+{
+
+}
@@ -0,0 +1,18 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Exception;
+
+/**
+ * Handle malformed or out of range values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Exception
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class InvalidValueException extends XmlException
+{
+
+}
@@ -0,0 +1,268 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Contract\CacheableValue;
+
+/**
+ * Least recently used cache of encoded sub-values, by request and
+ * optionally into APC. Only immutable collections (keyed by a hash of
+ * their content) and CacheableValue objects (keyed by their cache key)
+ * are cached: object ids are reused once an object is freed, so they can
+ * not identify a value.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class FragmentCache
+{
+    /**
+     * The APC keys prefix.
+     *
+     * @var string
+     */
+    const string APC_PREFIX = 'ivyhjk.xml.fragment.';
+
+    /**
+     * The fragments with their height, least recently used first.
+     *
+     * @var Map<string, (string, int)>
+     */
+    private static Map<string, (string, int)> $fragments = Map{};
+
+    /**
+     * Whether the fragments are shared through APC.
+     *
+     * @var bool
+     */
+    private static bool $apc = false;
+
+    /**
+     * The APC entries time to live, in seconds (0 for no expiration).
+     *
+     * @var int
+     */
+    private static int $apcTtl = 0;
+
+    /**
+     * The lookups found into the cache.
+     *
+     * @var int
+     */
+    private static int $hits = 0;
+
+    /**
+     * The lookups not found into the cache.
+     *
+     * @var int
+     */
+    private static int $misses = 0;
+
+    /**
+     * Share (or stop sharing) the fragments between requests with APC.
+     *
+     * @param bool $enabled
+     * @param int $ttl The entries time to live, in seconds (0 for no expiration).
+     *
+     * @return void
+     */
+    public static function useApc(bool $enabled, int $ttl = 0) : void
+    {
+        self::$apc = $enabled;
+        self::$apcTtl = $ttl;
+    }
+
+    /**
+     * Check if the cache is enabled (see Config::setFragmentCacheSize).
+     *
+     * @return bool
+     */
+    public static function isEnabled() : bool
+    {
+        return Config::getFragmentCacheSize() > 0;
+    }
+
+    /**
+     * Get the cache key of a value, scoped by Config::getFragmentScope so
+     * fragments of other encoders or library versions are not reused.
+     *
+     * @param mixed $value
+     *
+     * @return ?string Null when the value is not cacheable.
+     */
+    public static function getKey(mixed $value) : ?string
+    {
+        if ($value instanceof CacheableValue) {
+            $key = $value->getCacheKey();
+        } else if ($value instanceof ImmMap || $value instanceof ImmVector || $value instanceof ImmSet) {
+            $key = \md5(\serialize($value));
+        } else {
+            return null;
+        }
+
+        return Config::getFragmentScope() . '.' . \get_class($value) . '#' . $key;
+    }
+
+    /**
+     * Get a fragment, marking it as recently used.
+     *
+     * @param string $key
+     *
+     * @return ?(string, int) The fragment and its height, as given to set().
+     */
+    public static function get(string $key) : ?(string, int)
+    {
+        $entry = self::$fragments->get($key);
+
+        if ($entry !== null) {
+            self::$hits++;
+
+            // Move it to the most recently used end.
+            self::$fragments->remove($key);
+            self::$fragments->set($key, $entry);
+
+            return $entry;
+        }
+
+        if (self::$apc) {
+            $cached = \apc_fetch(self::APC_PREFIX . $key);
+
+            // Stored as "height:fragment".
+            $separator = \is_string($cached) ? \strpos($cached, ':') : false;
+
+            if (\is_string($cached) && $separator !== false) {
+                self::$hits++;
+
+                $entry = tuple((string) \substr($cached, $separator + 1), (int) \substr($cached, 0, $separator));
+
+                static::store($key, $entry);
+
+                return $entry;
+            }
+        }
+
+        self::$misses++;
+
+        return null;
+    }
+
+    /**
+     * Keep a fragment, evicting the least recently used past the size.
+     *
+     * @param string $key
+     * @param string $fragment The encoded type element.
+     * @param int $height The nesting levels of the fragment, checked against
+     *  the depth limit where it is reused.
+     *
+     * @return void
+     */
+    public static function set(string $key, string $fragment, int $height) : void
+    {
+        static::store($key, tuple($fragment, $height));
+
+        if (self::$apc) {
+            \apc_store(self::APC_PREFIX . $key, $height . ':' . $fragment, self::$apcTtl);
+        }
+    }
+
+    /**
+     * Measure the height of a fragment: the deepest nesting of <value>
+     * elements into it, zero for a scalar.
+     *
+     * @param string $fragment The encoded type element.
+     *
+     * @return int
+     */
+    public static function measure(string $fragment) : int
+    {
+        $height = 0;
+        $level = 0;
+        $offset = 0;
+
+        // The text is escaped, every "<" opens a tag.
+        while (($offset = \strpos($fragment, '<', $offset)) !== false) {
+            if (\substr_compare($fragment, '<value>', $offset, 7) === 0) {
+                $level++;
+                $height = \max($height, $level);
+            } else if (\substr_compare($fragment, '</value>', $offset, 8) === 0) {
+                $level--;
+            } else if (\substr_compare($fragment, '<value/>', $offset, 8) === 0) {
+                $height = \max($height, $level + 1);
+            }
+
+            $offset++;
+        }
+
+        return $height;
+    }
+
+    /**
+     * Get the lookups found into the cache.
+     *
+     * @return int
+     */
+    public static function getHits() : int
+    {
+        return self::$hits;
+    }
+
+    /**
+     * Get the lookups not found into the cache.
+     *
+     * @return int
+     */
+    public static function getMisses() : int
+    {
+        return self::$misses;
+    }
+
+    /**
+     * Get the number of fragments kept by this request.
+     *
+     * @return int
+     */
+    public static function count() : int
+    {
+        return self::$fragments->count();
+    }
+
+    /**
+     * Forget the fragments of this request and reset the counters.
+     *
+     * @return void
+     */
+    public static function clear() : void
+    {
+        self::$fragments->clear();
+        self::$hits = 0;
+        self::$misses = 0;
+    }
+
+    /**
+     * Keep a fragment into the request cache.
+     *
+     * @param string $key
+     * @param (string, int) $entry The fragment and its height.
+     *
+     * @return void
+     */
+    private static function store(string $key, (string, int) $entry) : void
+    {
+        $size = Config::getFragmentCacheSize();
+
+        self::$fragments->remove($key);
+        self::$fragments->set($key, $entry);
+
+        while (self::$fragments->count() > $size) {
+            $oldest = self::$fragments->firstKey();
+
+            invariant($oldest !== null, 'The cache is not empty.');
+
+            self::$fragments->remove($oldest);
+        }
+    }
+}
@@ -0,0 +1,249 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Read the JSON tokens out of a string or a stream. A stream is read in
+ * fixed size chunks, only the token being read is kept whole in memory.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class JsonReader
+{
+    /**
+     * The bytes read from the stream at once.
+     *
+     * @var int
+     */
+    const int CHUNK_SIZE = 8192;
+
+    /**
+     * The JSON whitespace characters.
+     *
+     * @var string
+     */
+    const string WHITESPACE = " \t\n\r";
+
+    /**
+     * The read bytes not consumed yet, from the position.
+     *
+     * @var string
+     */
+    private string $buffer;
+
+    /**
+     * The next byte into the buffer.
+     *
+     * @var int
+     */
+    private int $position = 0;
+
+    /**
+     * The bytes dropped from the buffer, for the error offsets.
+     *
+     * @var int
+     */
+    private int $dropped = 0;
+
+    /**
+     * Create a new reader.
+     *
+     * @param ?resource $stream The input stream, null when the whole input is given.
+     * @param string $json The input, or the bytes already read from the stream.
+     *
+     * @return void
+     */
+    public function __construct(private ?resource $stream, string $json = '') : void
+    {
+        $this->buffer = $json;
+    }
+
+    /**
+     * Create a reader of a string or of a readable stream.
+     *
+     * @param mixed $input
+     *
+     * @return Ivyhjk\Xml\JsonReader
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function fromInput(mixed $input) : JsonReader
+    {
+        if (\is_string($input)) {
+            return new JsonReader(null, $input);
+        }
+
+        if (\is_resource($input) && \get_resource_type($input) === 'stream') {
+            return new JsonReader($input);
+        }
+
+        throw new XmlException('A string or a readable stream was expected.');
+    }
+
+    /**
+     * Get the offset of the next byte into the whole input.
+     *
+     * @return int
+     */
+    public function getOffset() : int
+    {
+        return $this->dropped + $this->position;
+    }
+
+    /**
+     * Skip the whitespace and get the next character, without consuming it.
+     *
+     * @return ?string Null at the end of the input.
+     */
+    public function peek() : ?string
+    {
+        while (true) {
+            $this->position += \strspn($this->buffer, static::WHITESPACE, $this->position);
+
+            if ($this->position < \strlen($this->buffer)) {
+                return $this->buffer[$this->position];
+            }
+
+            if ( ! $this->fill(1)) {
+                return null;
+            }
+        }
+    }
+
+    /**
+     * Consume the peeked character.
+     *
+     * @return void
+     */
+    public function skip() : void
+    {
+        $this->position++;
+    }
+
+    /**
+     * Check if the next bytes are a literal, without consuming them.
+     *
+     * @param string $literal
+     *
+     * @return bool
+     */
+    public function startsWith(string $literal) : bool
+    {
+        $length = \strlen($literal);
+
+        return $this->fill($length) && \substr($this->buffer, $this->position, $length) === $literal;
+    }
+
+    /**
+     * Read a string, only its own bytes are decoded.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function readString() : string
+    {
+        if ($this->peek() !== '"') {
+            throw new XmlException(\sprintf('A string was expected into the JSON at %d.', $this->getOffset()));
+        }
+
+        // Relative to the position, the buffer may be compacted.
+        $end = 1;
+
+        while (true) {
+            $end += \strcspn($this->buffer, '"\\', $this->position + $end);
+
+            if ($this->position + $end >= \strlen($this->buffer)) {
+                if ( ! $this->fill($end + 1)) {
+                    throw new XmlException('Unclosed JSON string.');
+                }
+
+                continue;
+            }
+
+            if ($this->buffer[$this->position + $end] === '"') {
+                break;
+            }
+
+            // Skip the escaped character.
+            $end += 2;
+        }
+
+        $text = \json_decode(\substr($this->buffer, $this->position, $end + 1));
+
+        if ( ! \is_string($text)) {
+            throw new XmlException(\sprintf('Invalid JSON string at %d.', $this->getOffset()));
+        }
+
+        $this->position += $end + 1;
+
+        return $text;
+    }
+
+    /**
+     * Read a number, integers are int and any other number is float.
+     *
+     * @return num
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function readNumber() : num
+    {
+        $this->peek();
+
+        while (true) {
+            $size = \strspn($this->buffer, '0123456789+-.eE', $this->position);
+
+            // A number may go on into the next chunk.
+            if ($this->position + $size < \strlen($this->buffer) || ! $this->fill($size + 1)) {
+                break;
+            }
+        }
+
+        $number = \json_decode(\substr($this->buffer, $this->position, $size));
+
+        if ( ! \is_int($number) && ! \is_float($number)) {
+            throw new XmlException(\sprintf('Invalid JSON number at %d.', $this->getOffset()));
+        }
+
+        $this->position += $size;
+
+        return $number;
+    }
+
+    /**
+     * Make at least a number of bytes available from the position, as far
+     * as the input goes.
+     *
+     * @param int $size
+     *
+     * @return bool Whether they are available.
+     */
+    private function fill(int $size) : bool
+    {
+        while (\strlen($this->buffer) - $this->position < $size) {
+            $stream = $this->stream;
+
+            if ($stream === null || \feof($stream)) {
+                return false;
+            }
+
+            $chunk = (string) \fread($stream, static::CHUNK_SIZE);
+
+            // Drop the consumed bytes, a token being read is moved once at most.
+            if ($this->position > 0) {
+                $this->dropped += $this->position;
+                $this->buffer = (string) \substr($this->buffer, $this->position);
+                $this->position = 0;
+            }
+
+            $this->buffer .= $chunk;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,186 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Metadata;
+
+use ReflectionClass;
+use ReflectionProperty;
+
+/**
+ * The serializable properties of a class, in declaration order.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Metadata
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class ClassMetadata
+{
+    /**
+     * The constructor parameters positions, by name.
+     *
+     * @var Map<string, int>
+     */
+    private Map<string, int> $positions = Map{};
+
+    /**
+     * The public instance properties, for lookups.
+     *
+     * @var Set<string>
+     */
+    private Set<string> $properties = Set{};
+
+    /**
+     * Generate a new class description.
+     *
+     * @param string $className The class name.
+     * @param Vector<string> $names The public instance properties.
+     * @param Map<string, string> $types The declared property types, when available.
+     * @param Vector<shape(...)> $parameters The constructor parameters, in order.
+     *
+     * @return void
+     */
+    public function __construct(
+        private string $className,
+        private Vector<string> $names,
+        private Map<string, string> $types,
+        private Vector<shape(
+            'name' => string,
+            'type' => ?string,
+            'optional' => bool,
+            'nullable' => bool,
+            'default' => mixed
+        )> $parameters = Vector{}
+    ) : void
+    {
+        // Built once with the description, so it is cached along with it.
+        foreach ($parameters as $position => $parameter) {
+            $this->positions->set($parameter['name'], $position);
+        }
+
+        $this->properties->addAll($names);
+    }
+
+    /**
+     * Describe a class from its reflection.
+     *
+     * @param string $className The class name.
+     *
+     * @return Ivyhjk\Xml\Metadata\ClassMetadata
+     */
+    public static function fromClass(string $className) : ClassMetadata
+    {
+        $reflection = new ReflectionClass($className);
+
+        $names = Vector{};
+        $types = Map{};
+
+        foreach ($reflection->getProperties(ReflectionProperty::IS_PUBLIC) as $property) {
+            if ($property->isStatic()) {
+                continue;
+            }
+
+            $name = $property->getName();
+            $names->add($name);
+
+            // The Hack type hint, empty for untyped properties.
+            $type = $property->getTypeText();
+
+            if ($type !== '') {
+                $types->set($name, $type);
+            }
+        }
+
+        $parameters = Vector{};
+        $constructor = $reflection->getConstructor();
+
+        if ($constructor !== null) {
+            foreach ($constructor->getParameters() as $parameter) {
+                $type = $parameter->getTypeText();
+
+                $parameters->add(shape(
+                    'name' => $parameter->getName(),
+                    'type' => $type === '' ? null : $type,
+                    'optional' => $parameter->isDefaultValueAvailable(),
+                    'nullable' => $parameter->allowsNull(),
+                    'default' => $parameter->isDefaultValueAvailable() ? $parameter->getDefaultValue() : null,
+                ));
+            }
+        }
+
+        return new ClassMetadata($reflection->getName(), $names, $types, $parameters);
+    }
+
+    /**
+     * Get the class name.
+     *
+     * @return string
+     */
+    public function getClassName() : string
+    {
+        return $this->className;
+    }
+
+    /**
+     * Get the property names, in declaration order.
+     *
+     * @return Vector<string>
+     */
+    public function getNames() : Vector<string>
+    {
+        return $this->names;
+    }
+
+    /**
+     * Get the declared type of a property.
+     *
+     * @param string $name The property name.
+     *
+     * @return ?string Null when the property has no type hint.
+     */
+    public function getType(string $name) : ?string
+    {
+        return $this->types->get($name);
+    }
+
+    /**
+     * Get the constructor parameters, in order.
+     *
+     * @return Vector<shape(...)>
+     */
+    public function getParameters() : Vector<shape(
+        'name' => string,
+        'type' => ?string,
+        'optional' => bool,
+        'nullable' => bool,
+        'default' => mixed
+    )>
+    {
+        return $this->parameters;
+    }
+
+    /**
+     * Get the position of a constructor parameter.
+     *
+     * @param string $name The parameter name.
+     *
+     * @return ?int Null when the constructor has no such parameter.
+     */
+    public function getParameterPosition(string $name) : ?int
+    {
+        return $this->positions->get($name);
+    }
+
+    /**
+     * Check if a public instance property exists.
+     *
+     * @param string $name The property name.
+     *
+     * @return bool
+     */
+    public function hasProperty(string $name) : bool
+    {
+        return $this->properties->contains($name);
+    }
+}
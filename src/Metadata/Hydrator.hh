@@ -0,0 +1,542 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Metadata;
+
+use DateTime;
+use DOMDocument;
+use ReflectionClass;
+use DateTimeInterface;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Caster;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Build objects of a given class straight from <value> nodes, the struct
+ * members are matched with the constructor parameters or the public
+ * properties of the class.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Metadata
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Hydrator
+{
+    /**
+     * Declared types holding a list of objects, the item class is captured.
+     *
+     * @var string
+     */
+    const string LIST_PATTERN = '/^(?:HH\\\\)?(?:array|vec|Vector|ImmVector|ConstVector|Traversable)<\\\\?([A-Za-z_][A-Za-z0-9_\\\\]*)>$/';
+
+    /**
+     * Declared types decoded into Hack arrays.
+     *
+     * @var string
+     */
+    const string HACK_ARRAY_PATTERN = '/^(?:HH\\\\)?(?:vec|dict|keyset)\b/';
+
+    /**
+     * hydrate instructions: convert a node into a declared type, build
+     * instances of a class from a node, and pop the built values into a
+     * Vector or an object.
+     *
+     * @var int
+     */
+    const int CONVERT = 0;
+    const int HYDRATE = 1;
+    const int BUILD_LIST = 2;
+    const int BUILD_OBJECT = 3;
+
+    /**
+     * The reflections used to build the objects, by class name.
+     *
+     * @var Map<string, ReflectionClass>
+     */
+    private static Map<string, ReflectionClass> $reflections = Map{};
+
+    /**
+     * Build a value of the given class from a <value> node. Structs become
+     * instances of the class, arrays become vectors of them.
+     *
+     * The nested values are walked with an explicit stack in post-order,
+     * like Value::parseValue: the member values are built first into
+     * $results, then the BUILD_* instructions pop them into their object
+     * or list. Values without class are read with Value::fromNode from
+     * their own depth, so Config::getMaxDepth holds for the whole document.
+     *
+     * @param SimpleXMLElement $valueNode The <value> node.
+     * @param string $className The class to build.
+     * @param DOMDocument $document The root node.
+     * @param int $depth The nesting level of the node.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    public static function hydrate(
+        SimpleXMLElement $valueNode,
+        string $className,
+        DOMDocument $document,
+        int $depth = 1
+    ) : mixed
+    {
+        $maxDepth = Config::getMaxDepth();
+
+        $results = Vector{};
+        $stack = Vector{};
+
+        $stack->add(tuple(self::HYDRATE, $valueNode, $className, $depth, null, Vector{}));
+
+        while ( ! $stack->isEmpty()) {
+            list($instruction, $node, $type, $depth, $metadata, $targets) = $stack->pop();
+
+            switch ($instruction) {
+                case self::CONVERT:
+                    invariant($node !== null, 'A value node was expected.');
+
+                    $type = \ltrim($type, '?@\\');
+                    $matches = [];
+
+                    // The list is built as a Vector, then made the declared container.
+                    if (\preg_match(static::LIST_PATTERN, $type, $matches) === 1 && static::isHydratable($matches[1])) {
+                        $stack->add(tuple(self::HYDRATE, $node, $matches[1], $depth, null, Vector{}));
+                    } else if (static::isHydratable($type)) {
+                        $stack->add(tuple(self::HYDRATE, $node, $type, $depth, null, Vector{}));
+                    } else {
+                        $results->add(static::convert($node, $type, $document, $depth));
+                    }
+                    break;
+                case self::HYDRATE:
+                    invariant($node !== null, 'A value node was expected.');
+
+                    if ($depth > $maxDepth) {
+                        throw new DepthLimitExceeded($maxDepth);
+                    }
+
+                    $typedNode = static::getTypedNode($node);
+
+                    if ($typedNode === null) {
+                        $results->add(Value::parseValue(Value::fromNode($node, $document, $depth)));
+
+                        break;
+                    }
+
+                    $typeName = $typedNode->getName();
+
+                    if ($typeName === Struct::TAG_NAME) {
+                        static::pushMembers($stack, $typedNode, MetadataCache::get($type), $depth);
+                    } else if ($typeName === ArrayData::TAG_NAME) {
+                        $itemNodes = ArrayData::getValueNodes($typedNode);
+
+                        $stack->add(tuple(self::BUILD_LIST, null, '', \count($itemNodes), null, Vector{}));
+
+                        for ($i = \count($itemNodes) - 1; $i >= 0; $i--) {
+                            $stack->add(tuple(self::HYDRATE, $itemNodes[$i], $type, $depth + 1, null, Vector{}));
+                        }
+                    } else {
+                        $results->add(Caster::cast($typeName, $typedNode));
+                    }
+                    break;
+                case self::BUILD_LIST:
+                    // The item count travels into the depth field.
+                    $offset = $results->count() - $depth;
+
+                    $items = Vector{};
+                    $items->reserve($depth);
+
+                    for ($i = $offset; $i < $results->count(); $i++) {
+                        $items->add($results->at($i));
+                    }
+
+                    $results->resize($offset, null);
+                    $results->add($items);
+                    break;
+                case self::BUILD_OBJECT:
+                    invariant($metadata !== null, 'A class description was expected.');
+
+                    $offset = $results->count() - $targets->count();
+                    $object = static::build($metadata, $targets, $results, $offset);
+
+                    $results->resize($offset, null);
+                    $results->add($object);
+                    break;
+            }
+        }
+
+        return $results->firstValue();
+    }
+
+    /**
+     * Forget the reflections of this request.
+     *
+     * @return void
+     */
+    public static function clear() : void
+    {
+        self::$reflections->clear();
+    }
+
+    /**
+     * Push the members of a <struct> node matching a constructor parameter
+     * or a public property, the object is built once they are converted.
+     *
+     * @param Vector<(int, ?SimpleXMLElement, string, int, ?ClassMetadata, Vector<(?int, ?string)>)> $stack
+     * @param SimpleXMLElement $structNode The <struct> node.
+     * @param Ivyhjk\Xml\Metadata\ClassMetadata $metadata The class to build.
+     * @param int $depth The nesting level of the struct.
+     *
+     * @return void
+     */
+    private static function pushMembers(
+        Vector<(int, ?SimpleXMLElement, string, int, ?ClassMetadata, Vector<(?int, ?string)>)> $stack,
+        SimpleXMLElement $structNode,
+        ClassMetadata $metadata,
+        int $depth
+    ) : void
+    {
+        $parameters = $metadata->getParameters();
+
+        $targets = Vector{};
+        $members = Vector{};
+
+        foreach ($structNode->xpath(Member::TAG_NAME) as $memberNode) {
+            list($name, $memberValueNode) = Member::parseNode($memberNode);
+
+            $position = $metadata->getParameterPosition($name);
+
+            if ($position !== null) {
+                $targets->add(tuple($position, null));
+                $members->add(tuple($memberValueNode, $parameters->at($position)['type']));
+            } else if ($metadata->hasProperty($name)) {
+                $targets->add(tuple(null, $name));
+                $members->add(tuple($memberValueNode, $metadata->getType($name)));
+            }
+        }
+
+        $stack->add(tuple(self::BUILD_OBJECT, null, '', $depth, $metadata, $targets));
+
+        for ($i = $members->count() - 1; $i >= 0; $i--) {
+            list($memberValueNode, $type) = $members->at($i);
+
+            $stack->add(tuple(self::CONVERT, $memberValueNode, $type ?? '', $depth + 1, null, Vector{}));
+        }
+    }
+
+    /**
+     * Build an object from its converted members.
+     *
+     * @param Ivyhjk\Xml\Metadata\ClassMetadata $metadata The class to build.
+     * @param Vector<(?int, ?string)> $targets The parameter position or the
+     *  property name of each member.
+     * @param Vector<mixed> $results The converted values.
+     * @param int $offset The position of the first member into $results.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    private static function build(
+        ClassMetadata $metadata,
+        Vector<(?int, ?string)> $targets,
+        Vector<mixed> $results,
+        int $offset
+    ) : mixed
+    {
+        $parameters = $metadata->getParameters();
+
+        $arguments = Map{};
+        $properties = Map{};
+
+        foreach ($targets as $i => $target) {
+            list($position, $name) = $target;
+
+            if ($position !== null) {
+                $name = $parameters->at($position)['name'];
+                $type = $parameters->at($position)['type'];
+            } else if ($name !== null) {
+                $type = $metadata->getType($name);
+            } else {
+                continue;
+            }
+
+            $value = static::toDeclared($results->at($offset + $i), $type ?? '');
+
+            // The engine would throw a TypeError instead.
+            if ( ! static::accepts($value, $type ?? '')) {
+                throw new InvalidNodeException(\sprintf(
+                    'Member "%s" does not match the type "%s" to build "%s".',
+                    $name,
+                    (string) $type,
+                    $metadata->getClassName()
+                ));
+            }
+
+            if ($position !== null) {
+                $arguments->set($position, $value);
+            } else {
+                $properties->set($name, $value);
+            }
+        }
+
+        $values = Vector{};
+        $values->reserve($parameters->count());
+
+        foreach ($parameters as $position => $parameter) {
+            if ($arguments->containsKey($position)) {
+                $values->add($arguments->at($position));
+            } else if ($parameter['optional']) {
+                $values->add($parameter['default']);
+            } else if ($parameter['nullable']) {
+                $values->add(null);
+            } else {
+                throw new InvalidNodeException(\sprintf(
+                    'Member "%s" is required to build "%s".',
+                    $parameter['name'],
+                    $metadata->getClassName()
+                ));
+            }
+        }
+
+        $object = static::getReflection($metadata->getClassName())->newInstanceArgs($values);
+
+        foreach ($properties as $name => $value) {
+            /* HH_FIXME[2011] */
+            $object->$name = $value;
+        }
+
+        return $object;
+    }
+
+    /**
+     * Convert a <value> node into a declared type without class to build.
+     *
+     * @param SimpleXMLElement $valueNode The <value> node.
+     * @param string $type The declared type, empty when unknown.
+     * @param DOMDocument $document The root node.
+     * @param int $depth The nesting level of the node.
+     *
+     * @return mixed
+     */
+    private static function convert(
+        SimpleXMLElement $valueNode,
+        string $type,
+        DOMDocument $document,
+        int $depth
+    ) : mixed
+    {
+        $typedNode = static::getTypedNode($valueNode);
+
+        if ($typedNode !== null && $typedNode->getName() !== Struct::TAG_NAME
+            && $typedNode->getName() !== ArrayData::TAG_NAME
+        ) {
+            $maxDepth = Config::getMaxDepth();
+
+            if ($depth > $maxDepth) {
+                throw new DepthLimitExceeded($maxDepth);
+            }
+
+            $value = Caster::cast($typedNode->getName(), $typedNode);
+
+            if ($value instanceof Timestamp && $type !== '' && \is_a($type, DateTimeInterface::class, true)) {
+                $date = $value->toDateTime();
+
+                // toDateTime gives immutable dates, DateTime targets need a mutable one.
+                if (\is_a($type, DateTime::class, true)) {
+                    return new DateTime($date->format('Y-m-d H:i:s.u'), $date->getTimezone());
+                }
+
+                return $date;
+            }
+
+            return $value;
+        }
+
+        $mode = \preg_match(static::HACK_ARRAY_PATTERN, $type) === 1
+            ? OutputMode::HACK_ARRAY
+            : OutputMode::COLLECTION;
+
+        return Value::parseValue(Value::fromNode($valueNode, $document, $depth), $mode);
+    }
+
+    /**
+     * Make a decoded value the declared container: the Vector and Map
+     * results become arrays, Hack arrays or immutable collections, and
+     * integers become floats for float targets.
+     *
+     * @param mixed $value
+     * @param string $type The declared type, empty when unknown.
+     *
+     * @return mixed
+     */
+    private static function toDeclared(mixed $value, string $type) : mixed
+    {
+        $base = static::getBaseType($type);
+
+        if ($value instanceof Vector) {
+            switch ($base) {
+                case 'array':
+                    return $value->toArray();
+                case 'vec':
+                    return vec($value);
+                case 'keyset':
+                    return keyset($value);
+                case 'ImmVector':
+                    return $value->toImmVector();
+            }
+        } else if ($value instanceof Map) {
+            switch ($base) {
+                case 'array':
+                    return $value->toArray();
+                case 'dict':
+                    return dict($value);
+                case 'ImmMap':
+                    return $value->toImmMap();
+            }
+        } else if ($base === 'float' && \is_int($value)) {
+            return (float) $value;
+        }
+
+        return $value;
+    }
+
+    /**
+     * Check if a decoded value matches a declared type. Only the outer type
+     * is checked, types without a check (aliases, shapes, generics) match.
+     *
+     * @param mixed $value
+     * @param string $type The declared type, empty when unknown.
+     *
+     * @return bool
+     */
+    private static function accepts(mixed $value, string $type) : bool
+    {
+        $base = static::getBaseType($type);
+
+        if ($base === '' || $base === 'mixed') {
+            return true;
+        }
+
+        if ($value === null) {
+            return \strpos(\ltrim($type, '@'), '?') === 0;
+        }
+
+        switch ($base) {
+            case 'int':
+                return \is_int($value);
+            case 'float':
+                return \is_float($value);
+            case 'num':
+                return \is_int($value) || \is_float($value);
+            case 'string':
+                return \is_string($value);
+            case 'arraykey':
+                return \is_int($value) || \is_string($value);
+            case 'bool':
+                return \is_bool($value);
+            case 'array':
+                return \is_array($value);
+            case 'vec':
+                return is_vec($value);
+            case 'dict':
+                return is_dict($value);
+            case 'keyset':
+                return is_keyset($value);
+        }
+
+        if (\class_exists($base) || \interface_exists($base)) {
+            return \is_object($value) && \is_a($value, $base);
+        }
+
+        return true;
+    }
+
+    /**
+     * Get the outer type of a declared type, without nullability, namespace
+     * root or type arguments. Ex: ?HH\Vector<Foo> gives Vector.
+     *
+     * @param string $type
+     *
+     * @return string
+     */
+    private static function getBaseType(string $type) : string
+    {
+        $type = \ltrim($type, '?@\\');
+
+        if (\strpos($type, 'HH\\') === 0) {
+            $type = \substr($type, 3);
+        }
+
+        return \substr($type, 0, \strcspn($type, '<'));
+    }
+
+    /**
+     * Get the only typed child of a <value> node.
+     *
+     * @param SimpleXMLElement $valueNode
+     *
+     * @return ?SimpleXMLElement Null when the node is not a single typed value.
+     */
+    private static function getTypedNode(SimpleXMLElement $valueNode) : ?SimpleXMLElement
+    {
+        if ($valueNode->getName() !== Value::TAG_NAME) {
+            throw new InvalidNodeException(\sprintf(
+                'Invalid tag name for "%s".',
+                Value::TAG_NAME
+            ));
+        }
+
+        $children = $valueNode->xpath('*');
+
+        if (\count($children) !== 1) {
+            return null;
+        }
+
+        return $children[0];
+    }
+
+    /**
+     * Check if a declared type is a user class to build objects of.
+     *
+     * @param string $type
+     *
+     * @return bool
+     */
+    private static function isHydratable(string $type) : bool
+    {
+        if ($type === '' || ! \class_exists($type)) {
+            return false;
+        }
+
+        return ! static::getReflection($type)->isInternal();
+    }
+
+    /**
+     * Get the reflection of a class, built once.
+     *
+     * @param string $className
+     *
+     * @return ReflectionClass
+     */
+    private static function getReflection(string $className) : ReflectionClass
+    {
+        $reflection = self::$reflections->get($className);
+
+        if ($reflection === null) {
+            $reflection = new ReflectionClass($className);
+
+            self::$reflections->set($className, $reflection);
+        }
+
+        return $reflection;
+    }
+}
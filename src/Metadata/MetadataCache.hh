@@ -0,0 +1,151 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Metadata;
+
+use ReflectionClass;
+use Ivyhjk\Xml\Config;
+
+/**
+ * Cache of the class descriptions, by request and optionally into APC.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Metadata
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class MetadataCache
+{
+    /**
+     * The APC keys prefix.
+     *
+     * @var string
+     */
+    const string APC_PREFIX = 'ivyhjk.xml.metadata.';
+
+    /**
+     * The descriptions of this request, by class name.
+     *
+     * @var Map<string, Ivyhjk\Xml\Metadata\ClassMetadata>
+     */
+    private static Map<string, ClassMetadata> $classes = Map{};
+
+    /**
+     * The APC keys of this request, by class name.
+     *
+     * @var Map<string, string>
+     */
+    private static Map<string, string> $keys = Map{};
+
+    /**
+     * Whether the descriptions are shared through APC.
+     *
+     * @var bool
+     */
+    private static bool $apc = false;
+
+    /**
+     * Share (or stop sharing) the descriptions between requests with APC.
+     *
+     * @param bool $enabled
+     *
+     * @return void
+     */
+    public static function useApc(bool $enabled) : void
+    {
+        self::$apc = $enabled;
+    }
+
+    /**
+     * Get the description of a class, computed once.
+     *
+     * @param string $className The class name, as given by get_class.
+     *
+     * @return Ivyhjk\Xml\Metadata\ClassMetadata
+     */
+    public static function get(string $className) : ClassMetadata
+    {
+        $metadata = self::$classes->get($className);
+
+        if ($metadata !== null) {
+            return $metadata;
+        }
+
+        if (self::$apc) {
+            $cached = \apc_fetch(static::getApcKey($className));
+
+            if ($cached instanceof ClassMetadata) {
+                self::$classes->set($className, $cached);
+
+                return $cached;
+            }
+        }
+
+        $metadata = ClassMetadata::fromClass($className);
+
+        self::$classes->set($className, $metadata);
+
+        if (self::$apc) {
+            \apc_store(static::getApcKey($className), $metadata);
+        }
+
+        return $metadata;
+    }
+
+    /**
+     * Get the APC key of a class description, computed once by request. It
+     * holds the cache format and the version of the files declaring the
+     * class, its parent classes and its traits, so a description is not
+     * reused once the library or any of those declarations changed.
+     *
+     * @param string $className
+     *
+     * @return string
+     */
+    public static function getApcKey(string $className) : string
+    {
+        $key = self::$keys->get($className);
+
+        if ($key !== null) {
+            return $key;
+        }
+
+        $versions = Vector{};
+        $pending = Vector{new ReflectionClass($className)};
+
+        while (!$pending->isEmpty()) {
+            $class = $pending->pop();
+            $file = $class->getFileName();
+
+            if (\is_string($file)) {
+                $versions->add($class->getName() . ':' . $file . ':' . (int) \filemtime($file));
+            }
+
+            $parent = $class->getParentClass();
+
+            if ($parent instanceof ReflectionClass) {
+                $pending->add($parent);
+            }
+
+            $pending->addAll($class->getTraits());
+        }
+
+        $key = self::APC_PREFIX . Config::CACHE_FORMAT . '.' . $className . '.' . \md5(\implode("\n", $versions));
+
+        self::$keys->set($className, $key);
+
+        return $key;
+    }
+
+    /**
+     * Forget the descriptions and the APC keys of this request.
+     *
+     * @return void
+     */
+    public static function clear() : void
+    {
+        self::$classes->clear();
+        self::$keys->clear();
+    }
+}
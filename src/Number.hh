@@ -0,0 +1,165 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Exception\InvalidValueException;
+
+/**
+ * Locale independent number formatting and parsing.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Number
+{
+    /**
+     * Strict <double> grammar, the exponent is accepted because big and
+     * tiny doubles are written with it.
+     *
+     * @var string
+     */
+    const string DOUBLE_PATTERN = '/^[+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?$/';
+
+    /**
+     * Digits of the biggest integers, by sign.
+     *
+     * @var string
+     */
+    const string INT64_MAX_DIGITS = '9223372036854775807';
+    const string INT64_MIN_DIGITS = '9223372036854775808';
+
+    /**
+     * Format a double with the shortest digits that parse back to the
+     * exact same double.
+     *
+     * Like Grisu, it tries the 15 significant digits every double can hold
+     * and only falls back to 16 and 17 digits when needed. Numbers from
+     * 1e-4 to 1e15 are written in decimal notation, any other with an
+     * exponent (1.0E+20), as the (string) cast did.
+     *
+     * @param float $value The double to format.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    public static function formatDouble(float $value) : string
+    {
+        if ( ! \is_finite($value)) {
+            throw new InvalidValueException('NAN and INF can not be sent as a double.');
+        }
+
+        if ($value == 0.0) {
+            return \sprintf('%e', $value)[0] === '-' ? '-0' : '0';
+        }
+
+        $sign = $value < 0 ? '-' : '';
+        $absolute = \abs($value);
+
+        $digits = '';
+        $exponent = 0;
+
+        for ($precision = 14; $precision <= 16; $precision++) {
+            // The mantissa always ends with $precision decimals, whatever the
+            // locale decimal point is.
+            $formatted = \sprintf('%.' . $precision . 'e', $absolute);
+            $exponentAt = \strrpos($formatted, 'e');
+            $mantissa = \substr($formatted, 0, $exponentAt);
+
+            $digits = $mantissa[0] . \substr($mantissa, -$precision);
+            $exponent = (int) \substr($formatted, $exponentAt + 1);
+
+            if ((float) ($digits[0] . '.' . \substr($digits, 1) . 'e' . $exponent) === $absolute) {
+                break;
+            }
+        }
+
+        $digits = \rtrim($digits, '0');
+
+        if ($exponent < -4 || $exponent >= 15) {
+            $fraction = \strlen($digits) > 1 ? \substr($digits, 1) : '0';
+
+            return \sprintf('%s%s.%sE%s%d', $sign, $digits[0], $fraction, $exponent < 0 ? '-' : '+', \abs($exponent));
+        }
+
+        if ($exponent < 0) {
+            return $sign . '0.' . \str_repeat('0', -$exponent - 1) . $digits;
+        }
+
+        if (\strlen($digits) <= $exponent + 1) {
+            return $sign . \str_pad($digits, $exponent + 1, '0');
+        }
+
+        return $sign . \substr($digits, 0, $exponent + 1) . '.' . \substr($digits, $exponent + 1);
+    }
+
+    /**
+     * Parse a <double> text, malformed numbers are rejected instead of
+     * being read as 0.
+     *
+     * @param string $text The double text.
+     *
+     * @return float
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    public static function parseDouble(string $text) : float
+    {
+        $text = \trim($text);
+
+        if ( ! \preg_match(self::DOUBLE_PATTERN, $text)) {
+            throw new InvalidValueException(\sprintf('Invalid double value: "%s"', $text));
+        }
+
+        return (float) $text;
+    }
+
+    /**
+     * Parse an <int>, <i4> or <i8> text, malformed and out of range
+     * numbers are rejected instead of being read as 0 or clamped.
+     *
+     * The digits are validated and counted with strspn, the text is only
+     * compared against the limit when it has as many digits as the limit.
+     *
+     * @param string $text The integer text.
+     * @param int $bits The integer size, 32 or 64.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    public static function parseInt(string $text, int $bits = 64) : int
+    {
+        $text = \trim($text);
+        $length = \strlen($text);
+
+        $offset = ($length > 0 && ($text[0] === '-' || $text[0] === '+')) ? 1 : 0;
+        $digits = \strspn($text, '0123456789', $offset);
+
+        if ($digits === 0 || $offset + $digits !== $length) {
+            throw new InvalidValueException(\sprintf('Invalid integer value: "%s"', $text));
+        }
+
+        $negative = $text[0] === '-';
+
+        // Leading zeros do not count.
+        $start = $offset + \strspn($text, '0', $offset);
+        $significant = $length - $start;
+        $limit = $negative ? self::INT64_MIN_DIGITS : self::INT64_MAX_DIGITS;
+
+        if ($significant > \strlen($limit)
+            || ($significant === \strlen($limit) && \strcmp(\substr($text, $start), $limit) > 0)
+        ) {
+            throw new InvalidValueException(\sprintf('Integer value out of range: "%s"', $text));
+        }
+
+        $value = (int) $text;
+
+        if ($bits === 32 && ($value < -2147483648 || $value > 2147483647)) {
+            throw new InvalidValueException(\sprintf('Integer value out of range: "%s"', $text));
+        }
+
+        return $value;
+    }
+}
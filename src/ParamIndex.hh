@@ -0,0 +1,367 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Exception;
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Param;
+use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Byte offsets of the top level params of an encoded document, so a single
+ * param (or struct member) is decoded without decoding the others. The index
+ * is a plain object: it can be serialized and cached next to the body.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class ParamIndex
+{
+    /**
+     * The last body checked against the index, so repeated lookups into
+     * the same body do not hash it again. It is not serialized.
+     *
+     * @var ?string
+     */
+    private ?string $verified = null;
+
+    /**
+     * Create a new index.
+     *
+     * @param int $length The indexed body length.
+     * @param string $checksum The indexed body crc32.
+     * @param Vector<(int, int)> $params The offset and length of each <param>.
+     * @param Vector<Map<string, (int, int)>> $members The offset and length of
+     *  the <member> nodes of the top level structs, by param.
+     * @param string $declaration The XML declaration of the indexed body,
+     *  prepended to each parsed node so it keeps the body encoding.
+     *
+     * @return void
+     */
+    public function __construct(
+        private int $length,
+        private string $checksum,
+        private Vector<(int, int)> $params,
+        private Vector<Map<string, (int, int)>> $members,
+        private string $declaration = ''
+    ) : void
+    {
+
+    }
+
+    /**
+     * Index a document in a single pass over its tags.
+     *
+     * @param string $xml The encoded <params>, <methodResponse> or <methodCall> document.
+     * @param bool $withMembers Index also the members of the top level structs.
+     *
+     * @return Ivyhjk\Xml\ParamIndex
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function build(string $xml, bool $withMembers = false) : ParamIndex
+    {
+        $params = Vector{};
+        $members = Vector{};
+
+        $stack = Vector{};
+        $length = \strlen($xml);
+        $offset = 0;
+
+        $paramDepth = -1;
+        $paramStart = 0;
+        $memberDepth = -1;
+        $memberStart = 0;
+        $memberName = null;
+
+        $declaration = '';
+        $encoding = 'UTF-8';
+
+        if (\strncmp($xml, '<?xml', 5) === 0) {
+            $declarationEnd = \strpos($xml, '?>');
+
+            if ($declarationEnd === false) {
+                throw new XmlException('Unterminated markup.');
+            }
+
+            $declaration = \substr($xml, 0, $declarationEnd + 2);
+
+            $matches = [];
+
+            if (\preg_match('/encoding\s*=\s*["\']([A-Za-z0-9._-]+)["\']/', $declaration, $matches) === 1) {
+                $encoding = \strtoupper($matches[1]);
+            }
+        }
+
+        while (($offset = \strpos($xml, '<', $offset)) !== false) {
+            $next = $xml[$offset + 1] ?? '';
+
+            // Prolog, comments, CDATA and declarations hold no tags.
+            if ($next === '?' || $next === '!') {
+                if (\substr($xml, $offset, 4) === '<!--') {
+                    $close = \strpos($xml, '-->', $offset);
+                } else if (\substr($xml, $offset, 9) === '<![CDATA[') {
+                    $close = \strpos($xml, ']]>', $offset);
+                } else {
+                    $close = \strpos($xml, '>', $offset);
+                }
+
+                if ($close === false) {
+                    throw new XmlException('Unterminated markup.');
+                }
+
+                $offset = $close + 1;
+
+                continue;
+            }
+
+            $tagEnd = \strpos($xml, '>', $offset);
+
+            if ($tagEnd === false) {
+                throw new XmlException('Unterminated tag.');
+            }
+
+            $closing = $next === '/';
+            $nameStart = $offset + ($closing ? 2 : 1);
+            $name = \substr($xml, $nameStart, \strcspn($xml, " \t\r\n/>", $nameStart));
+            $selfClosing = $xml[$tagEnd - 1] === '/';
+
+            if ($closing) {
+                if ($stack->isEmpty() || $stack->pop() !== $name) {
+                    throw new XmlException(\sprintf('Unexpected closing tag "%s".', $name));
+                }
+
+                $depth = $stack->count();
+
+                if ($name === Param::TAG_NAME && $depth === $paramDepth) {
+                    $params->add(tuple($paramStart, $tagEnd + 1 - $paramStart));
+                } else if ($name === Member::TAG_NAME && $depth === $memberDepth && $memberName !== null) {
+                    $members->at($members->count() - 1)->set(
+                        $memberName,
+                        tuple($memberStart, $tagEnd + 1 - $memberStart)
+                    );
+                }
+
+                $offset = $tagEnd + 1;
+
+                continue;
+            }
+
+            $depth = $stack->count();
+
+            if ($name === Param::TAG_NAME && $depth <= 2 && $stack->lastValue() === Params::TAG_NAME) {
+                $paramDepth = $depth;
+                $paramStart = $offset;
+                $members->add(Map{});
+                $memberDepth = $depth + 3;
+            } else if ($withMembers && $name === Member::TAG_NAME && $depth === $memberDepth
+                && $stack->lastValue() === Struct::TAG_NAME
+            ) {
+                $memberStart = $offset;
+                $memberName = null;
+            } else if ($withMembers && $name === 'name' && $depth === $memberDepth + 1
+                && $stack->lastValue() === Member::TAG_NAME && ! $selfClosing
+            ) {
+                $nameClose = \strpos($xml, '</name', $tagEnd);
+
+                if ($nameClose === false) {
+                    throw new XmlException('Unterminated tag "name".');
+                }
+
+                $memberName = \substr($xml, $tagEnd + 1, $nameClose - $tagEnd - 1);
+
+                // The names are looked up as UTF-8, like the decoded ones.
+                if ($encoding !== 'UTF-8') {
+                    $memberName = \mb_convert_encoding($memberName, 'UTF-8', $encoding);
+                }
+
+                $memberName = \html_entity_decode($memberName, \ENT_QUOTES | \ENT_XML1, 'UTF-8');
+            }
+
+            if ( ! $selfClosing) {
+                $stack->add($name);
+            }
+
+            $offset = $tagEnd + 1;
+        }
+
+        if ( ! $stack->isEmpty()) {
+            throw new XmlException(\sprintf('Unclosed tag "%s".', $stack->lastValue()));
+        }
+
+        $index = new ParamIndex($length, \hash('crc32b', $xml), $params, $members, $declaration);
+
+        // Built from this very body.
+        $index->verified = $xml;
+
+        return $index;
+    }
+
+    /**
+     * Keep the index data only when serialized, not the verified body.
+     *
+     * @return array<string>
+     */
+    public function __sleep() : array<string>
+    {
+        return ['length', 'checksum', 'params', 'members', 'declaration'];
+    }
+
+    /**
+     * Get the number of params.
+     *
+     * @return int
+     */
+    public function count() : int
+    {
+        return $this->params->count();
+    }
+
+    /**
+     * Get the offset and length of a <param> node.
+     *
+     * @param int $index The param position.
+     *
+     * @return (int, int)
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    public function getParam(int $index) : (int, int)
+    {
+        $bounds = $this->params->get($index);
+
+        if ($bounds === null) {
+            throw new InvalidNodeException(\sprintf('Param "%d" not found.', $index));
+        }
+
+        return $bounds;
+    }
+
+    /**
+     * Get the indexed member names of a param, empty when the members
+     * were not indexed or the param is not a struct.
+     *
+     * @param int $index The param position.
+     *
+     * @return Vector<string>
+     */
+    public function getMemberNames(int $index) : Vector<string>
+    {
+        $members = $this->members->get($index);
+
+        return $members === null ? Vector{} : $members->keys();
+    }
+
+    /**
+     * Check if the index belongs to a body, i.e. after a cache fetch.
+     *
+     * @param string $xml
+     *
+     * @return bool
+     */
+    public function matches(string $xml) : bool
+    {
+        return \strlen($xml) === $this->length && \hash('crc32b', $xml) === $this->checksum;
+    }
+
+    /**
+     * Decode a single param.
+     *
+     * @param string $xml The indexed body.
+     * @param int $index The param position.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function decodeParam(string $xml, int $index, OutputMode $mode = OutputMode::COLLECTION) : mixed
+    {
+        list($offset, $length) = $this->getParam($index);
+
+        $document = new DOMDocument();
+        $param = Param::fromNode($this->parseSlice($xml, $offset, $length), $document);
+
+        $parsedValues = Value::parseValues($param->getValues(), $mode);
+
+        if ($parsedValues->count() === 1) {
+            return $parsedValues->firstValue();
+        }
+
+        return Value::toList($parsedValues, $mode);
+    }
+
+    /**
+     * Decode a single member of a top level struct.
+     *
+     * @param string $xml The indexed body.
+     * @param int $index The param position.
+     * @param string $name The member name.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function decodeMember(
+        string $xml,
+        int $index,
+        string $name,
+        OutputMode $mode = OutputMode::COLLECTION
+    ) : mixed
+    {
+        $members = $this->members->get($index);
+        $bounds = $members === null ? null : $members->get($name);
+
+        if ($bounds === null) {
+            throw new InvalidNodeException(\sprintf('Member "%s" not indexed for param "%d".', $name, $index));
+        }
+
+        list($offset, $length) = $bounds;
+
+        $member = Member::fromNode($this->parseSlice($xml, $offset, $length), new DOMDocument());
+
+        return Value::parseValue($member->getValue(), $mode);
+    }
+
+    /**
+     * Parse a node out of the indexed body, under the body XML declaration
+     * so it is read with the body encoding.
+     *
+     * @param string $xml The indexed body.
+     * @param int $offset
+     * @param int $length
+     *
+     * @return SimpleXMLElement
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private function parseSlice(string $xml, int $offset, int $length) : SimpleXMLElement
+    {
+        // The body is hashed once, then only compared.
+        if ($xml !== $this->verified) {
+            if ( ! $this->matches($xml)) {
+                throw new XmlException('The document does not match the index.');
+            }
+
+            $this->verified = $xml;
+        }
+
+        \libxml_use_internal_errors(true);
+
+        try {
+            return new SimpleXMLElement(
+                $this->declaration . \substr($xml, $offset, $length),
+                Config::getParseOptions()
+            );
+        } catch (Exception $e) {
+            throw new XmlException($e->getMessage());
+        }
+    }
+}
@@ -8,8 +8,15 @@ use SimpleXMLElement;
 use Ivyhjk\Xml\Entity\Value;
 use Ivyhjk\Xml\Entity\Param;
 use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\ArrayData;
 use Ivyhjk\Xml\Entity\MethodResponse;
+use Ivyhjk\Xml\Type\Columnar;
+use Ivyhjk\Xml\Contract\Visitor;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Metadata\Hydrator;
 use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
 
 /**
  * XML RPC manager.
@@ -37,79 +44,322 @@ class RPC
 
         $document = new DOMDocument('1.0', $encoding);
 
-        $givenParams = Vector{};
+        $params = Params::fromValue($parameters, $document);
 
-        if (is_array($parameters) && \array_key_exists(0, $parameters)) {
-            foreach ($parameters as $parameter) {
-                $value = new Value(Vector{$parameter}, $document);
-                $param = new Param(Vector{$value}, $document);
+        $document->appendChild($params->getElement());
+
+        return $document->saveXML();
+    }
+
+    /**
+     * Encode parameters into the canonical XML RPC: logically equal values
+     * give the same bytes, whatever the members order.
+     *
+     * @param mixed $parameters RPC method args.
+     * @param string $encoding The XML encoding.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function encodeCanonical(mixed $parameters, string $encoding = 'utf-8') : string
+    {
+        return static::writeCanonical((new Writer(null, $encoding))->canonical(), $parameters)->getOutput();
+    }
 
-                $givenParams->add($param);
+    /**
+     * Hash the canonical XML RPC of the parameters while it is encoded, the
+     * encoded document is not kept. Meant for cache keys and ETags.
+     *
+     * @param mixed $parameters RPC method args.
+     * @param string $algorithm A hash_algos() algorithm.
+     *
+     * @return string The lowercase hexadecimal hash.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function hash(mixed $parameters, string $algorithm = 'sha256') : string
+    {
+        $writer = (new Writer())->canonical()->hashWith($algorithm, false);
+
+        return static::writeCanonical($writer, $parameters)->getHash();
+    }
+
+    /**
+     * Decode a XML RPC. With the DecodeCache enabled, repeated bodies are
+     * fetched from APC as immutable containers.
+     *
+     * @param string $xml
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections, Hack arrays or columns.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function decode(string $xml, OutputMode $mode = OutputMode::COLLECTION) : mixed
+    {
+        \libxml_use_internal_errors(true);
+
+        return static::decodeWith($xml, $mode, new DOMDocument());
+    }
+
+    /**
+     * Decode many XML RPC, the libxml setup and the entities document are
+     * shared by the whole batch. A failed document does not stop the batch,
+     * its error is kept at its position.
+     *
+     * Each document is still parsed into its own SimpleXMLElement and walked
+     * with its own stacks, as decode() does: SimpleXML can not reuse a
+     * parser, so the batch only saves the per call setup.
+     *
+     * @param Traversable<string> $documents
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections, Hack arrays or columns.
+     *
+     * @return Ivyhjk\Xml\BatchResult
+     */
+    public static function decodeMany(
+        Traversable<string> $documents,
+        OutputMode $mode = OutputMode::COLLECTION
+    ) : BatchResult
+    {
+        \libxml_use_internal_errors(true);
+
+        // The entities only create nodes with it, none is appended.
+        $document = new DOMDocument();
+
+        $values = Vector{};
+        $errors = Map{};
+
+        foreach ($documents as $xml) {
+            try {
+                $values->add(static::decodeWith($xml, $mode, $document));
+            } catch (XmlException $e) {
+                $errors->set($values->count(), $e);
+                $values->add(null);
+
+                // Do not let the parse errors pile up through the batch.
+                \libxml_clear_errors();
             }
-        } else {
-            $value = new Value(Vector{$parameters}, $document);
-            $param = new Param(Vector{$value}, $document);
-            $givenParams = Vector{$param};
         }
 
-        $params = new Params($givenParams, $document);
+        return new BatchResult($values, $errors);
+    }
 
-        $document->appendChild($params->getElement());
+    /**
+     * Decode a XML RPC through the DecodeCache, when enabled.
+     *
+     * @param string $xml
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections, Hack arrays or columns.
+     * @param DOMDocument $document The entities root node.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeWith(string $xml, OutputMode $mode, DOMDocument $document) : mixed
+    {
+        if ($mode === OutputMode::COLUMNAR || ! DecodeCache::accepts($xml)) {
+            return static::decodeDocument($xml, $mode, $document);
+        }
 
-        return $document->saveXML();
+        $key = DecodeCache::getKey($xml, $mode);
+        $cached = DecodeCache::fetch($key);
+
+        if ($cached !== null) {
+            return $cached;
+        }
+
+        return DecodeCache::store($key, static::decodeDocument($xml, $mode, $document));
+    }
+
+    /**
+     * Parse and decode a XML RPC.
+     *
+     * @param string $xml
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections, Hack arrays or columns.
+     * @param DOMDocument $document The entities root node.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeDocument(string $xml, OutputMode $mode, DOMDocument $document) : mixed
+    {
+        try {
+            $node = new SimpleXMLElement($xml, Config::getParseOptions());
+        } catch (Exception $e) {
+            throw new XmlException($e->getMessage());
+        }
+
+        if ($mode === OutputMode::COLUMNAR) {
+            return static::decodeParams(
+                $node,
+                $valueNode ==> static::decodeColumnar($valueNode, $document),
+                $mode
+            );
+        }
+
+        return static::decodeParams(
+            $node,
+            $valueNode ==> Value::parseValue(Value::fromNode($valueNode, $document), $mode),
+            $mode
+        );
+    }
+
+    /**
+     * Walk a XML RPC calling the visitor for each node, no values are built.
+     *
+     * @param string $xml
+     * @param Ivyhjk\Xml\Contract\Visitor $visitor
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function visit(string $xml, Visitor $visitor) : void
+    {
+        Walker::walk($xml, $visitor);
     }
 
     /**
-     * Decode a XML RPC.
+     * Check the structure of a XML RPC (<params> or <methodResponse>) without
+     * decoding its values.
      *
      * @param string $xml
+     * @param ?Vector<Ivyhjk\Xml\Contract\ValueType> $types The expected type of each param.
+     *
+     * @return Ivyhjk\Xml\ValidationResult
+     */
+    public static function validate(string $xml, ?Vector<ValueType> $types = null) : ValidationResult
+    {
+        return Validator::validate($xml, [Params::TAG_NAME, MethodResponse::TAG_NAME], $types);
+    }
+
+    /**
+     * Decode a XML RPC building objects of the given class from the structs,
+     * an array of structs becomes a vector of objects.
+     *
+     * @param string $xml
+     * @param string $className The class to build.
      *
      * @return mixed
      * @throws Ivyhjk\Xml\Exception\XmlException
      */
-    public static function decode(string $xml) : mixed
+    public static function decodeInto(string $xml, string $className) : mixed
     {
         \libxml_use_internal_errors(true);
 
         try {
-            $node = new SimpleXMLElement($xml);
+            $node = new SimpleXMLElement($xml, Config::getParseOptions());
         } catch (Exception $e) {
             throw new XmlException($e->getMessage());
         }
 
-        $decoded = Vector{};
         $document = new DOMDocument();
 
-        $processParams = (Params $paramsNode) ==> {
-            foreach ($paramsNode->getParameters() as $paramEntity) {
-                $valueEntities = $paramEntity->getValues();
+        return static::decodeParams(
+            $node,
+            $valueNode ==> Hydrator::hydrate($valueNode, $className, $document),
+            OutputMode::COLLECTION
+        );
+    }
 
-                $parsedValues = Value::parseValues($valueEntities);
+    /**
+     * Write the parameters as <params>, spread as Params::fromValue does.
+     *
+     * @param Ivyhjk\Xml\Writer $writer
+     * @param mixed $parameters RPC method args.
+     *
+     * @return Ivyhjk\Xml\Writer
+     */
+    private static function writeCanonical(Writer $writer, mixed $parameters) : Writer
+    {
+        $writer->startParams();
 
-                if ($parsedValues->count() === 1) {
-                    $decoded->add($parsedValues->firstValue());
-                } else {
-                    $decoded->add($parsedValues);
-                }
+        if (Params::isSpread($parameters)) {
+            invariant($parameters instanceof Traversable, 'Spread parameters are traversable.');
+
+            foreach ($parameters as $parameter) {
+                $writer->value($parameter);
             }
-        };
+        } else {
+            $writer->value($parameters);
+        }
 
+        return $writer->end();
+    }
+
+    /**
+     * Walk the <param> nodes of a <params> or <methodResponse> node, the
+     * single walker of the node based decoders. A param with several
+     * values becomes a list, as does a document with several params.
+     *
+     * @param SimpleXMLElement $node The <params> or <methodResponse> node.
+     * @param (function(SimpleXMLElement): mixed) $decodeValue Decode a param <value> node.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The lists container.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeParams(
+        SimpleXMLElement $node,
+        (function(SimpleXMLElement): mixed) $decodeValue,
+        OutputMode $mode
+    ) : mixed
+    {
         if ($node->getName() === MethodResponse::TAG_NAME) {
-            $methodResponse = MethodResponse::fromNode($node, $document);
+            $paramsNodes = $node->xpath(Params::TAG_NAME);
+        } else {
+            $paramsNodes = [$node];
+        }
+
+        $decoded = Vector{};
 
-            foreach ($methodResponse->getParameters() as $params) {
-                $processParams($params);
+        foreach ($paramsNodes as $paramsNode) {
+            if ($paramsNode->getName() !== Params::TAG_NAME) {
+                throw new InvalidNodeException(\sprintf('Missing node "%s"', Params::TAG_NAME));
             }
-        } else {
-            $params = Params::fromNode($node, $document);
 
-            $processParams($params);
+            foreach ($paramsNode->xpath(Param::TAG_NAME) as $paramNode) {
+                $parsedValues = Vector{};
+
+                foreach ($paramNode->xpath(Value::TAG_NAME) as $valueNode) {
+                    $parsedValues->add($decodeValue($valueNode));
+                }
+
+                if ($parsedValues->count() === 1) {
+                    $decoded->add($parsedValues->firstValue());
+                } else {
+                    $decoded->add(Value::toList($parsedValues, $mode));
+                }
+            }
         }
 
         if ($decoded->count() === 1) {
             return $decoded->firstValue();
-        } else {
-            return $decoded;
         }
+
+        return Value::toList($decoded, $mode);
+    }
+
+    /**
+     * Decode a param <value> node reading an array of structs as columns,
+     * straight from the nodes to skip the entities of the rows. Only the
+     * param value itself is read as columns: nested arrays, and arrays
+     * inside the cells, are decoded as in COLLECTION.
+     *
+     * @param SimpleXMLElement $valueNode The param <value> node.
+     * @param DOMDocument $document The root node.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeColumnar(SimpleXMLElement $valueNode, DOMDocument $document) : mixed
+    {
+        $typedNodes = $valueNode->xpath('*');
+
+        if (\count($typedNodes) === 1 && $typedNodes[0]->getName() === ArrayData::TAG_NAME) {
+            $columnar = Columnar::fromNode($typedNodes[0], $document);
+
+            if ($columnar !== null) {
+                return $columnar;
+            }
+        }
+
+        return Value::parseValue(Value::fromNode($valueNode, $document));
     }
 }
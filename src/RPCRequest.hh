@@ -6,12 +6,14 @@ use Exception;
 use DOMDocument;
 use SimpleXMLElement;
 use Ivyhjk\Xml\Entity\Value;
-use Ivyhjk\Xml\Entity\Param;
 use Ivyhjk\Xml\Entity\Params;
 use Ivyhjk\Xml\Entity\Struct;
 use Ivyhjk\Xml\Entity\MethodCall;
 use Ivyhjk\Xml\Entity\MethodName;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\OutputMode;
 use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
 
 /**
  * Manage XML RPC requests.
@@ -25,6 +27,13 @@ use Ivyhjk\Xml\Exception\XmlException;
  */
 class RPCRequest
 {
+    /**
+     * The bytes read at once when peeking a stream.
+     *
+     * @var int
+     */
+    const int PEEK_CHUNK_SIZE = 8192;
+
     /**
      * Encode an XML RPC request.
      *
@@ -43,22 +52,7 @@ class RPCRequest
 
         $methodName = new MethodName($method, $document);
 
-        $givenParams = Vector{};
-
-        if (is_array($parameters) && \array_key_exists(0, $parameters)) {
-            foreach ($parameters as $parameter) {
-                $value = new Value(Vector{$parameter}, $document);
-                $param = new Param(Vector{$value}, $document);
-
-                $givenParams->add($param);
-            }
-        } else {
-            $value = new Value(Vector{$parameters}, $document);
-            $param = new Param(Vector{$value}, $document);
-            $givenParams = Vector{$param};
-        }
-
-        $params = new Params($givenParams, $document);
+        $params = Params::fromValue($parameters, $document);
 
         $methodCall = new MethodCall($methodName, $params, $document);
 
@@ -67,46 +61,361 @@ class RPCRequest
         return $document->saveXML();
     }
 
+    /**
+     * Encode an XML RPC request once, to render it with other values of
+     * its Placeholder parameters.
+     *
+     * @param string $method RPC method.
+     * @param mixed $parameters RPC method args, with Placeholder leaves.
+     * @param string $encoding The XML encoding.
+     *
+     * @return Ivyhjk\Xml\RequestTemplate
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function prepare(string $method, mixed $parameters, string $encoding = 'iso-8859-1') : RequestTemplate
+    {
+        return RequestTemplate::prepare($method, $parameters, $encoding);
+    }
+
     /**
      * Decode an XML RPC request.
      *
      * @param string $xml The XML document to parse.
-     * @param string $method The XML RPC method.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections or Hack arrays.
      *
      * @return Map<string, mixed>
      * @throws Ivyhjk\Xml\Exception\XmlException
      */
-    public static function decode(string $xml) : Map<string, mixed>
+    public static function decode(string $xml, OutputMode $mode = OutputMode::COLLECTION) : Map<string, mixed>
     {
+        static::checkMode($mode);
+
+        \libxml_use_internal_errors(true);
+
+        return static::decodeDocument($xml, $mode, new DOMDocument());
+    }
+
+    /**
+     * Decode many XML RPC requests, the libxml setup and the entities
+     * document are shared by the whole batch. A failed request does not stop
+     * the batch, its error is kept at its position.
+     *
+     * Each request is still parsed into its own SimpleXMLElement and walked
+     * with its own stacks, as decode() does: SimpleXML can not reuse a
+     * parser, so the batch only saves the per call setup.
+     *
+     * @param Traversable<string> $documents
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections or Hack arrays.
+     *
+     * @return Ivyhjk\Xml\BatchResult The Map of each request, as decode().
+     * @throws Ivyhjk\Xml\Exception\XmlException When the mode is not supported.
+     */
+    public static function decodeMany(
+        Traversable<string> $documents,
+        OutputMode $mode = OutputMode::COLLECTION
+    ) : BatchResult
+    {
+        static::checkMode($mode);
+
         \libxml_use_internal_errors(true);
 
+        // The entities only create nodes with it, none is appended.
+        $document = new DOMDocument();
+
+        $values = Vector{};
+        $errors = Map{};
+
+        foreach ($documents as $xml) {
+            try {
+                $values->add(static::decodeDocument($xml, $mode, $document));
+            } catch (XmlException $e) {
+                $errors->set($values->count(), $e);
+                $values->add(null);
+
+                // Do not let the parse errors pile up through the batch.
+                \libxml_clear_errors();
+            }
+        }
+
+        return new BatchResult($values, $errors);
+    }
+
+    /**
+     * Check that the requests can be decoded with a mode, the columns are
+     * only read by RPC::decode.
+     *
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function checkMode(OutputMode $mode) : void
+    {
+        if ($mode === OutputMode::COLUMNAR) {
+            throw new XmlException('Requests can not be decoded as columns.');
+        }
+    }
+
+    /**
+     * Parse and decode an XML RPC request.
+     *
+     * @param string $xml The XML document to parse.
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode Decode into collections or Hack arrays.
+     * @param DOMDocument $document The entities root node.
+     *
+     * @return Map<string, mixed>
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeDocument(string $xml, OutputMode $mode, DOMDocument $document) : Map<string, mixed>
+    {
         try {
-            $element = new SimpleXMLElement($xml);
+            $element = new SimpleXMLElement($xml, Config::getParseOptions());
         } catch (Exception $e) {
             throw new XmlException($e->getMessage());
         }
 
         $parameters = Vector{};
 
-        $methodCallEntity = MethodCall::fromNode($element, new DOMDocument());
+        $methodCallEntity = MethodCall::fromNode($element, $document);
         $paramsEntity = $methodCallEntity->getParams();
         $paramEntities = $paramsEntity->getParameters();
 
         foreach ($paramEntities as $paramEntity) {
             $valueEntities = $paramEntity->getValues();
 
-            $parsedValues = Value::parseValues($valueEntities);
+            $parsedValues = Value::parseValues($valueEntities, $mode);
 
             if ($parsedValues->count() === 1) {
                 $parameters->add($parsedValues->firstValue());
             } else {
-                $parameters->add($parsedValues);
+                $parameters->add(Value::toList($parsedValues, $mode));
             }
         }
 
         return Map{
             'method' => $methodCallEntity->getMethodName()->getName(),
-            'parameters' => $parameters
+            'parameters' => Value::toList($parameters, $mode)
         };
     }
+
+    /**
+     * Check the structure of an XML RPC request without decoding its values.
+     *
+     * @param string $xml The XML document to check.
+     * @param ?Vector<Ivyhjk\Xml\Contract\ValueType> $types The expected type of each param.
+     *
+     * @return Ivyhjk\Xml\ValidationResult
+     */
+    public static function validate(string $xml, ?Vector<ValueType> $types = null) : ValidationResult
+    {
+        return Validator::validate($xml, [MethodCall::TAG_NAME], $types);
+    }
+
+    /**
+     * Get the method name of an XML RPC request without parsing it, the
+     * body is scanned only up to the closing </methodName> tag.
+     *
+     * @param mixed $input The XML document, as a string or a readable stream.
+     *  A stream is read in chunks of PEEK_CHUNK_SIZE bytes until the name is
+     *  found, so it is left after the last chunk read, not right after the
+     *  name: the bytes read past the name are not given back.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function peekMethod(mixed $input) : string
+    {
+        return static::readMethodName($input)[1][0];
+    }
+
+    /**
+     * Forward an XML RPC request under another method name: only the
+     * <methodName> element is rewritten, the bytes before and after it
+     * (the params included) are passed through untouched.
+     *
+     * Without validation the cost does not depend on the params size, a
+     * stream is copied into the output stream. With validation the whole
+     * request is checked (see validate()), a stream is read into memory.
+     *
+     * @param mixed $input The XML document, as a string or a readable stream.
+     * @param (function(string): string) $rename Get the new method name from the current one.
+     * @param ?resource $output The output stream, null to return the request.
+     * @param bool $validate Whether to check the request structure.
+     *
+     * @return string The request, empty when it was written into the stream.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    public static function proxy(
+        mixed $input,
+        (function(string): string) $rename,
+        ?resource $output = null,
+        bool $validate = false
+    ) : string
+    {
+        list($buffer, list($name, $start, $length)) = static::readMethodName($input);
+
+        // The new name is UTF-8, non ASCII characters are sent as references
+        // so they fit any document encoding.
+        $escaped = \mb_encode_numericentity(
+            \htmlspecialchars($rename($name), \ENT_XML1 | \ENT_NOQUOTES, 'UTF-8'),
+            [0x80, 0x10FFFF, 0, 0x1FFFFF],
+            'UTF-8'
+        );
+
+        $head = \substr_replace(
+            $buffer,
+            \sprintf('<%1$s>%2$s</%1$s>', MethodName::TAG_NAME, $escaped),
+            $start,
+            $length
+        );
+
+        if ($validate || ($output === null && \is_resource($input))) {
+            if (\is_resource($input)) {
+                $head .= (string) \stream_get_contents($input);
+            }
+
+            if ($validate) {
+                $result = static::validate($head);
+
+                if ( ! $result->isValid()) {
+                    throw new InvalidNodeException(\sprintf(
+                        '%s At %s (line %d, column %d).',
+                        (string) $result->getError(),
+                        $result->getPath(),
+                        $result->getLine(),
+                        $result->getColumn()
+                    ));
+                }
+            }
+        }
+
+        if ($output === null) {
+            return $head;
+        }
+
+        \fwrite($output, $head);
+
+        if ( ! $validate && \is_resource($input)) {
+            \stream_copy_to_stream($input, $output);
+        }
+
+        return '';
+    }
+
+    /**
+     * Read a request up to the end of its <methodName> element.
+     *
+     * @param mixed $input The XML document, as a string or a readable stream.
+     *
+     * @return (string, (string, int, int)) The bytes read, and the method
+     *  name with the offset and the length of its element.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function readMethodName(mixed $input) : (string, (string, int, int))
+    {
+        if (\is_string($input)) {
+            $located = static::scanMethodName($input, true);
+
+            invariant($located !== null, 'A complete document is always resolved.');
+
+            return tuple($input, $located);
+        }
+
+        if ( ! \is_resource($input)) {
+            throw new XmlException('Expected a string or a stream to read.');
+        }
+
+        $buffer = '';
+        $offset = 0;
+        $openTag = '<' . MethodName::TAG_NAME;
+
+        do {
+            $chunk = \fread($input, static::PEEK_CHUNK_SIZE);
+
+            if (\is_string($chunk)) {
+                $buffer .= $chunk;
+            }
+
+            $complete = ! \is_string($chunk) || $chunk === '' || \feof($input);
+
+            $located = static::scanMethodName($buffer, $complete, $offset);
+
+            if ($located === null) {
+                // Resume at the open tag once found, else at the bytes that
+                // may hold a tag split between two chunks.
+                $start = \strpos($buffer, $openTag, $offset);
+                $offset = $start === false ? \max(0, \strlen($buffer) - \strlen($openTag) + 1) : $start;
+            }
+        } while ($located === null);
+
+        return tuple($buffer, $located);
+    }
+
+    /**
+     * Find the method name into the beginning of a document.
+     *
+     * @param string $buffer The bytes read so far.
+     * @param bool $complete Whether no more bytes will come.
+     * @param int $offset Where to search from, the bytes before it were
+     *  already scanned.
+     *
+     * @return ?(string, int, int) The method name, and the offset and the
+     *  length of its element. Null when more bytes are needed.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function scanMethodName(string $buffer, bool $complete, int $offset = 0) : ?(string, int, int)
+    {
+        $openTag = '<' . MethodName::TAG_NAME;
+        $start = \strpos($buffer, $openTag, $offset);
+        $paramsStart = \strpos($buffer, '<' . Params::TAG_NAME, $offset);
+
+        // The name goes before the params, there is nothing to find past them.
+        if ($paramsStart !== false && ($start === false || $paramsStart < $start)) {
+            throw new XmlException(\sprintf('Tag "%s" not found.', MethodName::TAG_NAME));
+        }
+
+        $contentStart = $start === false ? false : \strpos($buffer, '>', $start);
+        $end = $contentStart === false
+            ? false
+            : \strpos($buffer, '</' . MethodName::TAG_NAME, $contentStart);
+        $elementEnd = $end === false ? false : \strpos($buffer, '>', $end);
+
+        if ($start === false || $contentStart === false || ($elementEnd === false && $buffer[$contentStart - 1] !== '/')) {
+            if ($complete) {
+                throw new XmlException(\sprintf('Tag "%s" not found.', MethodName::TAG_NAME));
+            }
+
+            return null;
+        }
+
+        invariant($start !== false && $contentStart !== false, 'Tag bounds are resolved.');
+
+        $afterName = $buffer[$start + \strlen($openTag)];
+
+        if ($afterName !== '>' && $afterName !== '/' && ! \ctype_space($afterName)) {
+            // Other tag with the same prefix, "<methodNameX>".
+            throw new XmlException(\sprintf('Tag "%s" not found.', MethodName::TAG_NAME));
+        }
+
+        // <methodName/>
+        if ($buffer[$contentStart - 1] === '/') {
+            return tuple('', $start, $contentStart - $start + 1);
+        }
+
+        invariant($end !== false && $elementEnd !== false, 'Closing tag is resolved.');
+
+        $content = \substr($buffer, $contentStart + 1, $end - $contentStart - 1);
+        $length = $elementEnd - $start + 1;
+
+        if (\strncmp($content, '<![CDATA[', 9) === 0 && \substr($content, -3) === ']]>') {
+            return tuple(\substr($content, 9, -3), $start, $length);
+        }
+
+        if (\strpos($content, '<') !== false) {
+            throw new XmlException(\sprintf('Invalid content for "%s".', MethodName::TAG_NAME));
+        }
+
+        return tuple(\html_entity_decode($content, \ENT_QUOTES | \ENT_XML1, 'UTF-8'), $start, $length);
+    }
 }
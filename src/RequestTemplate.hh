@@ -0,0 +1,171 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use DateTimeInterface;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Type\Placeholder;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * A request encoded once, rendered many times by binding its placeholders.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class RequestTemplate
+{
+    /**
+     * Create a new template.
+     *
+     * @param Vector<string> $segments The encoded bytes around the placeholders.
+     * @param Vector<string> $names The placeholder names, between the segments.
+     * @param string $encoding The XML encoding.
+     *
+     * @return void
+     */
+    public function __construct(
+        private Vector<string> $segments,
+        private Vector<string> $names,
+        private string $encoding
+    ) : void
+    {
+
+    }
+
+    /**
+     * Encode a request whose parameters hold placeholders.
+     *
+     * @param string $method RPC method.
+     * @param mixed $parameters RPC method args, with Placeholder leaves.
+     * @param string $encoding The XML encoding.
+     *
+     * @return Ivyhjk\Xml\RequestTemplate
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function prepare(string $method, mixed $parameters, string $encoding = 'iso-8859-1') : RequestTemplate
+    {
+        $xml = RPCRequest::encode($method, $parameters, $encoding);
+
+        $parts = \preg_split(
+            \sprintf('#<%1$s>(.*?)</%1$s>#s', \preg_quote(Placeholder::TAG_NAME, '#')),
+            $xml,
+            -1,
+            \PREG_SPLIT_DELIM_CAPTURE
+        );
+
+        $segments = Vector{};
+        $names = Vector{};
+
+        foreach ($parts as $index => $part) {
+            if ($index % 2 === 0) {
+                $segments->add($part);
+            } else {
+                $names->add(\html_entity_decode($part, \ENT_QUOTES | \ENT_XML1, 'UTF-8'));
+            }
+        }
+
+        return new RequestTemplate($segments, $names, $encoding);
+    }
+
+    /**
+     * Get the placeholder names, in document order.
+     *
+     * @return Vector<string>
+     */
+    public function getPlaceholders() : Vector<string>
+    {
+        return $this->names;
+    }
+
+    /**
+     * Render the request with the given values.
+     *
+     * @param KeyedContainer<string, mixed> $values The values by placeholder name.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    public function render(KeyedContainer<string, mixed> $values) : string
+    {
+        $output = $this->segments->at(0);
+
+        foreach ($this->names as $index => $name) {
+            $value = idx($values, $name);
+
+            if ($value === null) {
+                throw new InvalidValueException(\sprintf('Missing value for placeholder "%s".', $name));
+            }
+
+            $output .= $this->renderValue($value) . $this->segments->at($index + 1);
+        }
+
+        return $output;
+    }
+
+    /**
+     * Render the type element of a bound value.
+     *
+     * @param mixed $value
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    private function renderValue(mixed $value) : string
+    {
+        if (\is_int($value)) {
+            return '<' . ValueType::INTEGER . '>' . $value . '</' . ValueType::INTEGER . '>';
+        }
+
+        if (\is_string($value)) {
+            return '<' . ValueType::STRING . '>' . $this->escape($value) . '</' . ValueType::STRING . '>';
+        }
+
+        if (\is_float($value)) {
+            return '<' . ValueType::DOUBLE . '>' . Number::formatDouble($value) . '</' . ValueType::DOUBLE . '>';
+        }
+
+        if ($value instanceof DateTimeInterface) {
+            $value = Timestamp::fromDateTime($value);
+        }
+
+        if ($value instanceof Timestamp) {
+            return '<' . ValueType::DATETIME . '>' . $this->escape($value->getLexeme()) . '</' . ValueType::DATETIME . '>';
+        }
+
+        if ($value instanceof Base64) {
+            return '<' . ValueType::BASE64 . '>'
+                . \implode('', \iterator_to_array($value->encode(), false))
+                . '</' . ValueType::BASE64 . '>';
+        }
+
+        throw new UnsupportedValueType(\gettype($value));
+    }
+
+    /**
+     * Escape a bound text, the characters out of a single byte encoding
+     * are written as character references, as DOMDocument does.
+     *
+     * @param string $text An UTF-8 text.
+     *
+     * @return string
+     */
+    private function escape(string $text) : string
+    {
+        $escaped = \htmlspecialchars($text, \ENT_XML1 | \ENT_NOQUOTES | \ENT_SUBSTITUTE, 'UTF-8');
+
+        if (\strtolower($this->encoding) === 'utf-8') {
+            return $escaped;
+        }
+
+        return \mb_encode_numericentity($escaped, [0x80, 0x10FFFF, 0, 0x1FFFFF], 'UTF-8');
+    }
+}
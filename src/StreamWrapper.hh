@@ -0,0 +1,166 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+/**
+ * Expose an open stream through an URI, for the readers that only open
+ * URIs (XMLReader::open). The stream is read from its current position
+ * and is not closed with the URI.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class StreamWrapper
+{
+    /**
+     * The protocol of the URIs.
+     *
+     * @var string
+     */
+    const string PROTOCOL = 'ivyhjk-xml';
+
+    /**
+     * The exposed streams by URI identifier.
+     *
+     * @var Map<int, resource>
+     */
+    private static Map<int, resource> $streams = Map{};
+
+    /**
+     * The next URI identifier.
+     *
+     * @var int
+     */
+    private static int $nextId = 0;
+
+    /**
+     * The stream context, set by PHP.
+     *
+     * @var ?resource
+     */
+    public ?resource $context;
+
+    /**
+     * The stream read through this URI.
+     *
+     * @var ?resource
+     */
+    private ?resource $stream = null;
+
+    /**
+     * Expose a stream.
+     *
+     * @param resource $stream A readable stream.
+     *
+     * @return string The URI, to be released with release().
+     */
+    public static function expose(resource $stream) : string
+    {
+        if ( ! \in_array(static::PROTOCOL, \stream_get_wrappers(), true)) {
+            \stream_wrapper_register(static::PROTOCOL, static::class);
+        }
+
+        $id = self::$nextId++;
+
+        self::$streams->set($id, $stream);
+
+        return static::PROTOCOL . '://' . $id;
+    }
+
+    /**
+     * Stop exposing a stream, the stream itself is left open.
+     *
+     * @param string $uri The URI given by expose().
+     *
+     * @return void
+     */
+    public static function release(string $uri) : void
+    {
+        self::$streams->remove(static::getId($uri));
+    }
+
+    /**
+     * Open an URI, only for reading.
+     *
+     * @param string $uri
+     * @param string $mode
+     *
+     * @return bool
+     */
+    public function stream_open(string $uri, string $mode) : bool
+    {
+        if (\strpbrk($mode, 'waxc+') !== false) {
+            return false;
+        }
+
+        $this->stream = self::$streams->get(static::getId($uri));
+
+        return $this->stream !== null;
+    }
+
+    /**
+     * Read from the exposed stream.
+     *
+     * @param int $count The maximum number of bytes.
+     *
+     * @return string
+     */
+    public function stream_read(int $count) : string
+    {
+        $stream = $this->stream;
+
+        if ($stream === null) {
+            return '';
+        }
+
+        return (string) \fread($stream, $count);
+    }
+
+    /**
+     * Check if the exposed stream is exhausted.
+     *
+     * @return bool
+     */
+    public function stream_eof() : bool
+    {
+        $stream = $this->stream;
+
+        return $stream === null || \feof($stream);
+    }
+
+    /**
+     * Get the URI stats, none is known.
+     *
+     * @return array<string, int>
+     */
+    public function stream_stat() : array<string, int>
+    {
+        return [];
+    }
+
+    /**
+     * Close the URI, the exposed stream stays open.
+     *
+     * @return void
+     */
+    public function stream_close() : void
+    {
+        $this->stream = null;
+    }
+
+    /**
+     * Get the identifier of an URI.
+     *
+     * @param string $uri
+     *
+     * @return int
+     */
+    private static function getId(string $uri) : int
+    {
+        return (int) \substr($uri, \strlen(static::PROTOCOL) + 3);
+    }
+}
@@ -0,0 +1,304 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Visitor\JsonWriter;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Translate XML RPC into JSON and back in a single streaming pass: struct
+ * and object, array and array map directly, no native values are built.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Transcoder
+{
+    /**
+     * The open JSON containers kinds, the request is the object around
+     * the params of a <methodCall>.
+     *
+     * @var int
+     */
+    const int FRAME_PARAMS = 0;
+    const int FRAME_ARRAY = 1;
+    const int FRAME_OBJECT = 2;
+    const int FRAME_REQUEST = 3;
+
+    /**
+     * The JSON parser states: a value, a value or the end of an empty
+     * array, a key, a key or the end of an empty object, and a separator
+     * or the end of the container after a value.
+     *
+     * @var int
+     */
+    const int EXPECT_VALUE = 0;
+    const int EXPECT_FIRST_VALUE = 1;
+    const int EXPECT_KEY = 2;
+    const int EXPECT_FIRST_KEY = 3;
+    const int EXPECT_SEPARATOR = 4;
+
+    /**
+     * Translate a <params>, <methodResponse> or <methodCall> document into
+     * JSON (see JsonWriter for the documents layout).
+     *
+     * @param mixed $input The document, as a string or a readable stream.
+     * @param ?resource $stream The output stream, null to return the output.
+     *
+     * @return string The JSON, empty when it was written into the stream.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function toJson(mixed $input, ?resource $stream = null) : string
+    {
+        $writer = new JsonWriter($stream);
+
+        Walker::walk($input, $writer);
+
+        $writer->finish();
+
+        return $writer->getOutput();
+    }
+
+    /**
+     * Translate JSON into a <params> document. A top level array is spread
+     * into one <param> per item, anything else is a single <param> (like
+     * RPC::encode). Integers are <int>, other numbers are <double>.
+     *
+     * A top level object starting with "methodName" is a request (see
+     * JsonWriter) and gives a <methodCall>. A top level object starting with
+     * "fault" is rejected, the writer has no fault responses.
+     *
+     * @param mixed $input UTF-8 JSON, as a string or a readable stream.
+     * @param ?resource $stream The output stream, null to return the output.
+     * @param string $encoding The XML encoding.
+     *
+     * @return string The XML, empty when it was written into the stream.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function toXml(mixed $input, ?resource $stream = null, string $encoding = 'utf-8') : string
+    {
+        $reader = JsonReader::fromInput($input);
+        $writer = new Writer($stream, $encoding);
+
+        $frames = Vector{};
+        $state = static::start($reader, $writer, $frames);
+
+        while (true) {
+            $char = $reader->peek();
+
+            if ($char === null) {
+                break;
+            }
+
+            $offset = $reader->getOffset();
+
+            if ($state === self::EXPECT_SEPARATOR) {
+                $frame = $frames->lastValue();
+
+                if ($frame === null) {
+                    throw new XmlException(\sprintf('Unexpected "%s" after the JSON value at %d.', $char, $offset));
+                }
+
+                $reader->skip();
+
+                if ($frame === self::FRAME_REQUEST && $char !== '}') {
+                    throw new XmlException(\sprintf('Unexpected "%s" after the JSON request params at %d.', $char, $offset));
+                }
+
+                if ($char === ',') {
+                    $state = $frame === self::FRAME_OBJECT ? self::EXPECT_KEY : self::EXPECT_VALUE;
+                } else if ($char === ($frame === self::FRAME_ARRAY || $frame === self::FRAME_PARAMS ? ']' : '}')) {
+                    static::close($writer, $frames);
+                } else {
+                    throw new XmlException(\sprintf('Unexpected "%s" into the JSON at %d.', $char, $offset));
+                }
+
+                continue;
+            }
+
+            if ($state === self::EXPECT_KEY || $state === self::EXPECT_FIRST_KEY) {
+                if ($char === '}' && $state === self::EXPECT_FIRST_KEY) {
+                    $reader->skip();
+                    $state = self::EXPECT_SEPARATOR;
+
+                    static::close($writer, $frames);
+
+                    continue;
+                }
+
+                $writer->member(static::readKey($reader));
+                $state = self::EXPECT_VALUE;
+
+                continue;
+            }
+
+            if ($char === ']' && $state === self::EXPECT_FIRST_VALUE) {
+                $reader->skip();
+                $state = self::EXPECT_SEPARATOR;
+
+                static::close($writer, $frames);
+
+                continue;
+            }
+
+            $state = self::EXPECT_SEPARATOR;
+
+            // The writer checks the nesting of every value.
+            if ($char === '{' || $char === '[') {
+                $reader->skip();
+
+                if ($char === '{') {
+                    $writer->startStruct();
+                    $frames->add(self::FRAME_OBJECT);
+                    $state = self::EXPECT_FIRST_KEY;
+                } else {
+                    $writer->startArray();
+                    $frames->add(self::FRAME_ARRAY);
+                    $state = self::EXPECT_FIRST_VALUE;
+                }
+            } else if ($char === '"') {
+                $writer->string($reader->readString());
+            } else if ($char === '-' || \ctype_digit($char)) {
+                $number = $reader->readNumber();
+
+                if (\is_int($number)) {
+                    $writer->int($number);
+                } else {
+                    $writer->double((float) $number);
+                }
+            } else if ($reader->startsWith('true') || $reader->startsWith('false')) {
+                throw new UnsupportedValueType('boolean');
+            } else if ($reader->startsWith('null')) {
+                throw new UnsupportedValueType('NULL');
+            } else {
+                throw new XmlException(\sprintf('Unexpected "%s" into the JSON at %d.', $char, $offset));
+            }
+        }
+
+        if ($state !== self::EXPECT_SEPARATOR || ! $frames->isEmpty()) {
+            throw new XmlException('Unexpected end of the JSON.');
+        }
+
+        $writer->end();
+
+        if ( ! $writer->isComplete()) {
+            $writer->end();
+        }
+
+        return $stream === null ? $writer->getOutput() : '';
+    }
+
+    /**
+     * Open the document, out of the first JSON token.
+     *
+     * @param Ivyhjk\Xml\JsonReader $reader
+     * @param Ivyhjk\Xml\Writer $writer
+     * @param Vector<int> $frames The open containers.
+     *
+     * @return int The parser state.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function start(JsonReader $reader, Writer $writer, Vector<int> $frames) : int
+    {
+        $char = $reader->peek();
+
+        if ($char === '[') {
+            $reader->skip();
+            $writer->startParams();
+            $frames->add(self::FRAME_PARAMS);
+
+            return self::EXPECT_FIRST_VALUE;
+        }
+
+        if ($char !== '{') {
+            $writer->startParams();
+
+            return self::EXPECT_VALUE;
+        }
+
+        $reader->skip();
+
+        if ($reader->peek() === '}') {
+            $writer->startParams()->startStruct();
+            $frames->add(self::FRAME_OBJECT);
+
+            return self::EXPECT_FIRST_KEY;
+        }
+
+        $name = static::readKey($reader);
+
+        if ($name === 'fault') {
+            throw new XmlException('A JSON fault can not be translated, only params and requests are.');
+        }
+
+        if ($name !== 'methodName') {
+            $writer->startParams()->startStruct()->member($name);
+            $frames->add(self::FRAME_OBJECT);
+
+            return self::EXPECT_VALUE;
+        }
+
+        $method = $reader->readString();
+
+        if ($reader->peek() !== ',') {
+            throw new XmlException(\sprintf('A "," was expected into the JSON at %d.', $reader->getOffset()));
+        }
+
+        $reader->skip();
+
+        if (static::readKey($reader) !== 'params' || $reader->peek() !== '[') {
+            throw new XmlException(\sprintf('The request params were expected into the JSON at %d.', $reader->getOffset()));
+        }
+
+        $reader->skip();
+        $writer->startMethodCall($method)->startParams();
+        $frames->add(self::FRAME_REQUEST);
+        $frames->add(self::FRAME_PARAMS);
+
+        return self::EXPECT_FIRST_VALUE;
+    }
+
+    /**
+     * Read an object key and its ":".
+     *
+     * @param Ivyhjk\Xml\JsonReader $reader
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function readKey(JsonReader $reader) : string
+    {
+        $name = $reader->readString();
+
+        if ($reader->peek() !== ':') {
+            throw new XmlException(\sprintf('A ":" was expected into the JSON at %d.', $reader->getOffset()));
+        }
+
+        $reader->skip();
+
+        return $name;
+    }
+
+    /**
+     * Close the innermost JSON container.
+     *
+     * @param Ivyhjk\Xml\Writer $writer
+     * @param Vector<int> $frames The open containers.
+     *
+     * @return void
+     */
+    private static function close(Writer $writer, Vector<int> $frames) : void
+    {
+        // The <params> and the request are closed once the whole JSON was read.
+        $frame = $frames->pop();
+
+        if ($frame !== self::FRAME_PARAMS && $frame !== self::FRAME_REQUEST) {
+            $writer->end();
+        }
+    }
+}
@@ -0,0 +1,189 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Binary data sent as <base64>, from a string or from a stream.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Base64
+{
+    /**
+     * Bytes processed at once, multiple of 3 (raw) and 4 (encoded) so
+     * chunks never need padding.
+     *
+     * @var int
+     */
+    const int CHUNK_SIZE = 49152;
+
+    /**
+     * Generate a new binary value.
+     *
+     * @param ?string $data The raw data.
+     * @param ?resource $stream The stream to read the raw data from.
+     *
+     * @return void
+     */
+    private function __construct(private ?string $data, private ?resource $stream) : void
+    {
+
+    }
+
+    /**
+     * Generate a binary value from a string.
+     *
+     * @param string $data The raw data.
+     *
+     * @return Ivyhjk\Xml\Type\Base64
+     */
+    public static function fromString(string $data) : Base64
+    {
+        return new Base64($data, null);
+    }
+
+    /**
+     * Generate a binary value from a readable stream, it is read from its
+     * current position when encoded.
+     *
+     * @param resource $stream The stream.
+     *
+     * @return Ivyhjk\Xml\Type\Base64
+     */
+    public static function fromStream(resource $stream) : Base64
+    {
+        return new Base64(null, $stream);
+    }
+
+    /**
+     * Get the raw data, chunk by chunk.
+     *
+     * @return Iterator<string>
+     */
+    public function read() : Iterator<string>
+    {
+        $data = $this->data;
+
+        if ($data !== null) {
+            for ($offset = 0; $offset < \strlen($data); $offset += self::CHUNK_SIZE) {
+                yield \substr($data, $offset, self::CHUNK_SIZE);
+            }
+
+            return;
+        }
+
+        $stream = $this->stream;
+
+        invariant($stream !== null, 'A stream was expected.');
+
+        while ( ! \feof($stream)) {
+            // Unlike fread, it does not stop short on network streams.
+            $chunk = \stream_get_contents($stream, self::CHUNK_SIZE);
+
+            if ($chunk === false || $chunk === '') {
+                break;
+            }
+
+            yield $chunk;
+        }
+    }
+
+    /**
+     * Get the base64 encoded data, chunk by chunk.
+     *
+     * @return Iterator<string>
+     */
+    public function encode() : Iterator<string>
+    {
+        // The chunks size is a multiple of 3: no padding between them.
+        foreach ($this->read() as $chunk) {
+            yield \base64_encode($chunk);
+        }
+    }
+
+    /**
+     * Decode a base64 text. Values bigger than Config::getBase64SpillSize()
+     * are decoded chunk by chunk into a temporary stream (kept in memory up
+     * to that size, on disk after it).
+     *
+     * @param string $encoded The base64 text.
+     *
+     * @return mixed The decoded string, or a stream rewound to its start.
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function decode(string $encoded) : mixed
+    {
+        $spillSize = Config::getBase64SpillSize();
+
+        if (\intdiv(\strlen($encoded), 4) * 3 <= $spillSize) {
+            return static::decodeChunk(static::stripWhitespace($encoded));
+        }
+
+        $stream = \fopen('php://temp/maxmemory:' . $spillSize, 'w+b');
+
+        $carry = '';
+        $length = \strlen($encoded);
+
+        for ($offset = 0; $offset < $length; $offset += self::CHUNK_SIZE) {
+            $chunk = $carry . static::stripWhitespace(\substr($encoded, $offset, self::CHUNK_SIZE));
+
+            // Only whole groups of 4 characters can be decoded alone.
+            $usable = \strlen($chunk) - \strlen($chunk) % 4;
+
+            \fwrite($stream, static::decodeChunk(\substr($chunk, 0, $usable)));
+
+            $carry = (string) \substr($chunk, $usable);
+        }
+
+        if ($carry !== '') {
+            \fwrite($stream, static::decodeChunk($carry));
+        }
+
+        \rewind($stream);
+
+        return $stream;
+    }
+
+    /**
+     * Decode a chunk of base64 text.
+     *
+     * @param string $chunk The base64 text, without whitespace.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function decodeChunk(string $chunk) : string
+    {
+        $decoded = \base64_decode($chunk, true);
+
+        if ($decoded === false) {
+            throw new XmlException('Invalid base64 value.');
+        }
+
+        return $decoded;
+    }
+
+    /**
+     * Remove the line breaks and spaces of a base64 text.
+     *
+     * @param string $encoded The base64 text.
+     *
+     * @return string
+     */
+    private static function stripWhitespace(string $encoded) : string
+    {
+        if (\strpbrk($encoded, " \t\r\n") === false) {
+            return $encoded;
+        }
+
+        return \str_replace([' ', "\t", "\r", "\n"], '', $encoded);
+    }
+}
@@ -0,0 +1,227 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Caster;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+
+/**
+ * An array of structs stored by columns: one packed list per member name.
+ *
+ * Members missing from a row are stored as null, so every column has
+ * exactly getRowCount() items.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Columnar
+{
+    /**
+     * Generate a new columnar result.
+     *
+     * @param Map<string, Vector<mixed>> $columns The columns by member name.
+     * @param int $rowCount The number of structs.
+     *
+     * @return void
+     */
+    public function __construct(private Map<string, Vector<mixed>> $columns, private int $rowCount) : void
+    {
+
+    }
+
+    /**
+     * Get the number of rows (structs).
+     *
+     * @return int
+     */
+    public function getRowCount() : int
+    {
+        return $this->rowCount;
+    }
+
+    /**
+     * Get all the columns by member name.
+     *
+     * @return Map<string, Vector<mixed>>
+     */
+    public function getColumns() : Map<string, Vector<mixed>>
+    {
+        return $this->columns;
+    }
+
+    /**
+     * Get the column of a member name.
+     *
+     * @param string $name The member name.
+     *
+     * @return ?Vector<mixed> Null when no row has that member.
+     */
+    public function getColumn(string $name) : ?Vector<mixed>
+    {
+        return $this->columns->get($name);
+    }
+
+    /**
+     * Rebuild a single row as a struct.
+     *
+     * @param int $index The row index.
+     *
+     * @return Map<string, mixed>
+     */
+    public function getRow(int $index) : Map<string, mixed>
+    {
+        $row = Map{};
+
+        foreach ($this->columns as $name => $column) {
+            $row->set($name, $column->at($index));
+        }
+
+        return $row;
+    }
+
+    /**
+     * Generate a columnar result from an <array> node whose items are all
+     * structs. The structs are read straight from the XML nodes, without
+     * building an entity or a Map per row.
+     *
+     * @param SimpleXMLElement $node The <array> node.
+     * @param DOMDocument $document The root node, for nested values.
+     * @param int $depth The nesting depth of the <value> holding the <array>.
+     *
+     * @return ?Ivyhjk\Xml\Type\Columnar Null when the items are not all structs.
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    public static function fromNode(SimpleXMLElement $node, DOMDocument $document, int $depth = 1) : ?Columnar
+    {
+        $structNodes = Vector{};
+
+        foreach (ArrayData::getValueNodes($node) as $valueNode) {
+            $structNode = null;
+
+            // Exactly one <struct> per row <value>, the other items are
+            // left to the entity decoder (and its errors).
+            foreach ($valueNode->children() as $child) {
+                if ($structNode !== null || $child->getName() !== Struct::TAG_NAME) {
+                    return null;
+                }
+
+                $structNode = $child;
+            }
+
+            if ($structNode === null) {
+                return null;
+            }
+
+            $structNodes->add($structNode);
+        }
+
+        $rowCount = $structNodes->count();
+
+        if ($rowCount === 0) {
+            return null;
+        }
+
+        $maxDepth = Config::getMaxDepth();
+
+        // The rows <value> nodes.
+        if ($depth + 1 > $maxDepth) {
+            throw new DepthLimitExceeded($maxDepth);
+        }
+
+        $columns = Map{};
+        $casters = Map{};
+
+        foreach ($structNodes as $row => $structNode) {
+            foreach ($structNode->xpath(Member::TAG_NAME) as $memberNode) {
+                list($name, $valueNode) = Member::parseNode($memberNode);
+
+                $column = $columns->get($name);
+
+                if ($column === null) {
+                    $column = Vector{};
+                    $column->reserve($rowCount);
+
+                    $columns->set($name, $column);
+                }
+
+                $cell = static::parseCell($valueNode, $casters, $document, $depth + 2);
+
+                if ($column->count() > $row) {
+                    // Repeated member into the same struct, the last one wins.
+                    $column->set($row, $cell);
+
+                    continue;
+                }
+
+                // Rows without this member.
+                if ($column->count() < $row) {
+                    $column->resize($row, null);
+                }
+
+                $column->add($cell);
+            }
+        }
+
+        foreach ($columns as $column) {
+            $column->resize($rowCount, null);
+        }
+
+        return new Columnar($columns, $rowCount);
+    }
+
+    /**
+     * Parse the <value> node of a cell, scalars are cast directly.
+     *
+     * @param SimpleXMLElement $valueNode The member <value> node.
+     * @param Map<string, (function(SimpleXMLElement): mixed)> $casters The resolved casters.
+     * @param DOMDocument $document The root node, for nested values.
+     * @param int $depth The nesting depth of the <value> node.
+     *
+     * @return mixed
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    private static function parseCell(
+        SimpleXMLElement $valueNode,
+        Map<string, (function(SimpleXMLElement): mixed)> $casters,
+        DOMDocument $document,
+        int $depth
+    ) : mixed
+    {
+        $maxDepth = Config::getMaxDepth();
+
+        if ($depth > $maxDepth) {
+            throw new DepthLimitExceeded($maxDepth);
+        }
+
+        $typedNodes = $valueNode->xpath('*');
+
+        if (\count($typedNodes) === 1) {
+            $type = $typedNodes[0]->getName();
+
+            if ($type !== Struct::TAG_NAME && $type !== ArrayData::TAG_NAME) {
+                $caster = $casters->get($type);
+
+                if ($caster === null) {
+                    $caster = Caster::getCaster($type);
+                    $casters->set($type, $caster);
+                }
+
+                return $caster($typedNodes[0]);
+            }
+        }
+
+        return Value::parseValue(Value::fromNode($valueNode, $document, $depth));
+    }
+}
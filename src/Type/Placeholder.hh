@@ -0,0 +1,45 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+/**
+ * A named slot of a request template, bound to a value on render.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Placeholder
+{
+    /**
+     * The marker tag written in place of the value while preparing.
+     *
+     * @var string
+     */
+    const string TAG_NAME = 'ivyhjk.placeholder';
+
+    /**
+     * Create a new placeholder.
+     *
+     * @param string $name The name of the bound value.
+     *
+     * @return void
+     */
+    public function __construct(private string $name) : void
+    {
+
+    }
+
+    /**
+     * Get the name of the bound value.
+     *
+     * @return string
+     */
+    public function getName() : string
+    {
+        return $this->name;
+    }
+}
@@ -0,0 +1,44 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+use DOMElement;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Contract\TypeHandler;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Write the placeholders as marker tags, to split the prepared templates.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class PlaceholderHandler implements TypeHandler
+{
+    /**
+     * {@inheritdoc}
+     */
+    public function encode(mixed $value, DOMElement $valueElement) : void
+    {
+        invariant($value instanceof Placeholder, 'A placeholder was expected.');
+
+        $document = $valueElement->ownerDocument;
+
+        invariant($document !== null, 'The value element belongs to a document.');
+
+        $valueElement->appendChild($document->createElement(Placeholder::TAG_NAME))
+            ->appendChild($document->createTextNode($value->getName()));
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function decode(SimpleXMLElement $node) : mixed
+    {
+        throw new XmlException('Placeholders are not decoded.');
+    }
+}
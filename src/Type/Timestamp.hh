@@ -0,0 +1,154 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+use DateTimeZone;
+use DateTimeInterface;
+use DateTimeImmutable;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * A <dateTime.iso8601> value.
+ *
+ * Only the original text is kept, it is parsed the first time a date or
+ * an epoch is requested, and written back untouched when encoded.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Timestamp
+{
+    /**
+     * The XML tag name
+     *
+     * @var string
+     */
+    const string TAG_NAME = 'dateTime.iso8601';
+
+    /**
+     * The XML RPC date format, ex: 19980717T14:08:55
+     *
+     * @var string
+     */
+    const string FORMAT = 'Ymd\TH:i:s';
+
+    /**
+     * The parse format of FORMAT, the fields it lacks (the fraction of a
+     * second) are zero instead of the current time.
+     *
+     * @var string
+     */
+    const string PARSE_FORMAT = '!Ymd\TH:i:s';
+
+    /**
+     * The accepted texts: the XML RPC form, or the ISO 8601 extended form
+     * with optional fraction and timezone, ex: 1998-07-17T14:08:55.5+02:00
+     *
+     * @var string
+     */
+    const string PATTERN = '/^(\d{8}T\d{2}:\d{2}:\d{2}|\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}(\.\d+)?(Z|[+-]\d{2}:?\d{2})?)$/';
+
+    /**
+     * The parsed date, once requested.
+     *
+     * @var ?DateTimeImmutable
+     */
+    private ?DateTimeImmutable $date = null;
+
+    /**
+     * Generate a new date value.
+     *
+     * @param string $lexeme The date as sent into the XML.
+     *
+     * @return void
+     */
+    public function __construct(private string $lexeme) : void
+    {
+
+    }
+
+    /**
+     * Generate a date value from a native date.
+     *
+     * @param DateTimeInterface $date The date.
+     *
+     * @return Ivyhjk\Xml\Type\Timestamp
+     */
+    public static function fromDateTime(DateTimeInterface $date) : Timestamp
+    {
+        return new Timestamp($date->format(self::FORMAT));
+    }
+
+    /**
+     * Get the date as sent into the XML.
+     *
+     * @return string
+     */
+    public function getLexeme() : string
+    {
+        return $this->lexeme;
+    }
+
+    /**
+     * Get the date, dates without timezone are read as UTC.
+     *
+     * @return DateTimeImmutable
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function toDateTime() : DateTimeImmutable
+    {
+        $date = $this->date;
+
+        if ($date !== null) {
+            return $date;
+        }
+
+        $lexeme = \trim($this->lexeme);
+        $timezone = new DateTimeZone('UTC');
+
+        $date = DateTimeImmutable::createFromFormat(self::PARSE_FORMAT, $lexeme, $timezone);
+
+        if ($date === false) {
+            // The constructor also takes relative dates: "now", "+1 week".
+            if (\preg_match(self::PATTERN, $lexeme) !== 1) {
+                throw new XmlException(\sprintf('Invalid %s value: "%s"', self::TAG_NAME, $this->lexeme));
+            }
+
+            try {
+                // Any other ISO 8601 form: 1998-07-17T14:08:55+02:00
+                $date = new DateTimeImmutable($lexeme, $timezone);
+            } catch (\Exception $e) {
+                throw new XmlException(\sprintf('Invalid %s value: "%s"', self::TAG_NAME, $this->lexeme));
+            }
+        }
+
+        $this->date = $date;
+
+        return $date;
+    }
+
+    /**
+     * Get the date as an Unix timestamp.
+     *
+     * @return int
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public function toEpoch() : int
+    {
+        return $this->toDateTime()->getTimestamp();
+    }
+
+    /**
+     * Get the date as sent into the XML.
+     *
+     * @return string
+     */
+    public function __toString() : string
+    {
+        return $this->lexeme;
+    }
+}
@@ -0,0 +1,107 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Type;
+
+use DateTimeInterface;
+use Ivyhjk\Xml\Number;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * A list whose items all share the same type, sent as an <array>.
+ *
+ * The encoder trusts the hint: scalar items are written with the given
+ * type without checking them one by one, and structs reuse the members
+ * layout of the first item.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class TypedList
+{
+    /**
+     * Generate a new typed list.
+     *
+     * @param Ivyhjk\Xml\Contract\ValueType $type The type of every item.
+     * @param Traversable<mixed> $items The list items.
+     *
+     * @return void
+     */
+    public function __construct(private ValueType $type, private Traversable<mixed> $items) : void
+    {
+
+    }
+
+    /**
+     * Get the type of every item.
+     *
+     * @return Ivyhjk\Xml\Contract\ValueType
+     */
+    public function getType() : ValueType
+    {
+        return $this->type;
+    }
+
+    /**
+     * Get the list items.
+     *
+     * @return Traversable<mixed>
+     */
+    public function getItems() : Traversable<mixed>
+    {
+        return $this->items;
+    }
+
+    /**
+     * Get the text of a scalar item as written into its type tag, the
+     * single conversion of every encoder. Base64 items are the Base64
+     * values, raw strings or streams, date items the Timestamp values,
+     * native dates or lexemes.
+     *
+     * @param Ivyhjk\Xml\Contract\ValueType $type The scalar type.
+     * @param mixed $item
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    public static function toText(ValueType $type, mixed $item) : string
+    {
+        switch ($type) {
+            case ValueType::FLOAT:
+            case ValueType::DOUBLE:
+                return Number::formatDouble((float) $item);
+            case ValueType::BASE64:
+                if (\is_string($item)) {
+                    $item = Base64::fromString($item);
+                } else if (\is_resource($item) && \get_resource_type($item) === 'stream') {
+                    $item = Base64::fromStream($item);
+                }
+
+                if ( ! $item instanceof Base64) {
+                    throw new UnsupportedValueType(\gettype($item));
+                }
+
+                return \implode('', \iterator_to_array($item->encode(), false));
+            case ValueType::DATETIME:
+                if ($item instanceof DateTimeInterface) {
+                    $item = Timestamp::fromDateTime($item);
+                }
+
+                if ($item instanceof Timestamp) {
+                    return $item->getLexeme();
+                }
+
+                if ( ! \is_string($item)) {
+                    throw new UnsupportedValueType(\gettype($item));
+                }
+
+                return $item;
+        }
+
+        return (string) $item;
+    }
+}
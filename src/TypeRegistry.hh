@@ -0,0 +1,217 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use Ivyhjk\Xml\Contract\TypeHandler;
+
+/**
+ * Registry of the custom type handlers.
+ *
+ * Encoders are registered by class name, decoders by tag name. The class
+ * of every encoded object is resolved once (itself, then its parents and
+ * interfaces) and the result, handler or none, is kept in a table keyed by
+ * the class name.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class TypeRegistry
+{
+    /**
+     * The handlers by registered class name.
+     *
+     * @var Map<string, Ivyhjk\Xml\Contract\TypeHandler>
+     */
+    private static Map<string, TypeHandler> $encoders = Map{};
+
+    /**
+     * The resolved handlers by object class name, null for none.
+     *
+     * @var Map<string, ?Ivyhjk\Xml\Contract\TypeHandler>
+     */
+    private static Map<string, ?TypeHandler> $dispatch = Map{};
+
+    /**
+     * The handlers by tag name.
+     *
+     * @var Map<string, Ivyhjk\Xml\Contract\TypeHandler>
+     */
+    private static Map<string, TypeHandler> $decoders = Map{};
+
+    /**
+     * The signature of the registered handlers, once computed.
+     *
+     * @var ?string
+     */
+    private static ?string $signature = null;
+
+    /**
+     * The signature of the registered encoders, once computed.
+     *
+     * @var ?string
+     */
+    private static ?string $encoderSignature = null;
+
+    /**
+     * Register the encoder of a class, subclasses and implementations of
+     * an interface use it too.
+     *
+     * @param string $className The class or interface name.
+     * @param Ivyhjk\Xml\Contract\TypeHandler $handler The handler.
+     *
+     * @return void
+     */
+    public static function registerEncoder(string $className, TypeHandler $handler) : void
+    {
+        self::$encoders->set(\strtolower(\ltrim($className, '\\')), $handler);
+
+        // Resolved classes may now have another handler.
+        self::$dispatch->clear();
+        self::$signature = null;
+        self::$encoderSignature = null;
+    }
+
+    /**
+     * Register the decoder of a tag name.
+     *
+     * @param string $tagName The tag name, ex: money for <money>.
+     * @param Ivyhjk\Xml\Contract\TypeHandler $handler The handler.
+     *
+     * @return void
+     */
+    public static function registerDecoder(string $tagName, TypeHandler $handler) : void
+    {
+        self::$decoders->set($tagName, $handler);
+        self::$signature = null;
+    }
+
+    /**
+     * Remove every handler.
+     *
+     * @return void
+     */
+    public static function clear() : void
+    {
+        self::$encoders->clear();
+        self::$dispatch->clear();
+        self::$decoders->clear();
+        self::$signature = null;
+        self::$encoderSignature = null;
+    }
+
+    /**
+     * Get a signature of the registered handlers, it changes with any
+     * registration (see Config::getCacheScope).
+     *
+     * @return string
+     */
+    public static function getSignature() : string
+    {
+        $signature = self::$signature;
+
+        if ($signature === null) {
+            $handlers = [];
+
+            foreach (self::$encoders as $className => $handler) {
+                $handlers[] = 'encoder ' . $className . ' ' . \get_class($handler);
+            }
+
+            foreach (self::$decoders as $tagName => $handler) {
+                $handlers[] = 'decoder ' . $tagName . ' ' . \get_class($handler);
+            }
+
+            // The same handlers give the same signature, whatever the order.
+            \sort($handlers, \SORT_STRING);
+
+            $signature = \md5(\implode("\n", $handlers));
+
+            self::$signature = $signature;
+        }
+
+        return $signature;
+    }
+
+    /**
+     * Get a signature of the registered encoders only, the decoders do not
+     * change the encoded bytes (see Config::getFragmentScope).
+     *
+     * @return string
+     */
+    public static function getEncoderSignature() : string
+    {
+        $signature = self::$encoderSignature;
+
+        if ($signature === null) {
+            $handlers = [];
+
+            foreach (self::$encoders as $className => $handler) {
+                $handlers[] = $className . ' ' . \get_class($handler);
+            }
+
+            \sort($handlers, \SORT_STRING);
+
+            $signature = \md5(\implode("\n", $handlers));
+
+            self::$encoderSignature = $signature;
+        }
+
+        return $signature;
+    }
+
+    /**
+     * Get the encoder of an object.
+     *
+     * @param mixed $value The object.
+     *
+     * @return ?Ivyhjk\Xml\Contract\TypeHandler
+     */
+    public static function getEncoder(mixed $value) : ?TypeHandler
+    {
+        if (self::$encoders->isEmpty() || ! \is_object($value)) {
+            return null;
+        }
+
+        $className = \get_class($value);
+
+        if (self::$dispatch->containsKey($className)) {
+            return self::$dispatch->at($className);
+        }
+
+        $handler = null;
+
+        // The class itself first, then the parents, then the interfaces.
+        $candidates = \array_merge(
+            [$className],
+            \array_values(\class_parents($value)),
+            \array_values(\class_implements($value))
+        );
+
+        foreach ($candidates as $candidate) {
+            $handler = self::$encoders->get(\strtolower($candidate));
+
+            if ($handler !== null) {
+                break;
+            }
+        }
+
+        self::$dispatch->set($className, $handler);
+
+        return $handler;
+    }
+
+    /**
+     * Get the decoder of a tag name.
+     *
+     * @param string $tagName The tag name.
+     *
+     * @return ?Ivyhjk\Xml\Contract\TypeHandler
+     */
+    public static function getDecoder(string $tagName) : ?TypeHandler
+    {
+        return self::$decoders->get($tagName);
+    }
+}
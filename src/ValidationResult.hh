@@ -0,0 +1,86 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+/**
+ * The outcome of a document validation.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class ValidationResult
+{
+    /**
+     * Create a new validation result.
+     *
+     * @param ?string $error The failure reason, null when the document is valid.
+     * @param string $path The path of the failing node, i.e. "/params/param[2]/value".
+     * @param int $line The failing line, when known (0 otherwise).
+     * @param int $column The failing column, when known (0 otherwise).
+     *
+     * @return void
+     */
+    public function __construct(
+        private ?string $error = null,
+        private string $path = '',
+        private int $line = 0,
+        private int $column = 0
+    ) : void
+    {
+
+    }
+
+    /**
+     * Check if the document passed the validation.
+     *
+     * @return bool
+     */
+    public function isValid() : bool
+    {
+        return $this->error === null;
+    }
+
+    /**
+     * Get the failure reason.
+     *
+     * @return ?string
+     */
+    public function getError() : ?string
+    {
+        return $this->error;
+    }
+
+    /**
+     * Get the path of the failing node.
+     *
+     * @return string
+     */
+    public function getPath() : string
+    {
+        return $this->path;
+    }
+
+    /**
+     * Get the failing line, 0 when unknown.
+     *
+     * @return int
+     */
+    public function getLine() : int
+    {
+        return $this->line;
+    }
+
+    /**
+     * Get the failing column, 0 when unknown.
+     *
+     * @return int
+     */
+    public function getColumn() : int
+    {
+        return $this->column;
+    }
+}
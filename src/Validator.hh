@@ -0,0 +1,539 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use XMLReader;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Param;
+use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Entity\MethodCall;
+use Ivyhjk\Xml\Entity\MethodName;
+use Ivyhjk\Xml\Entity\MethodResponse;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+
+/**
+ * Check the structure of an XML RPC document in a single streamed pass,
+ * without building entities nor values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Validator
+{
+    /**
+     * The <fault> tag name.
+     *
+     * @var string
+     */
+    const string FAULT_TAG_NAME = 'fault';
+
+    /**
+     * The <name> tag name of the members.
+     *
+     * @var string
+     */
+    const string NAME_TAG_NAME = 'name';
+
+    /**
+     * The accepted base64 characters.
+     *
+     * @var string
+     */
+    const string BASE64_PATTERN = '/^[A-Za-z0-9+\/\s]*={0,2}\s*$/';
+
+    /**
+     * The elements allowed into each element.
+     *
+     * @var array<string, array<string>>
+     */
+    const array<string, array<string>> CHILDREN = [
+        'methodCall' => ['methodName', 'params'],
+        'methodResponse' => ['params', 'fault'],
+        'params' => ['param'],
+        'param' => ['value'],
+        'fault' => ['value'],
+        'struct' => ['member'],
+        'member' => ['name', 'value'],
+        'array' => ['data'],
+        'data' => ['value'],
+    ];
+
+    /**
+     * Validate a document.
+     *
+     * @param string $xml The document.
+     * @param array<string> $roots The accepted root elements.
+     * @param ?Vector<Ivyhjk\Xml\Contract\ValueType> $types The expected type
+     *  of each top level param, by position.
+     *
+     * @return Ivyhjk\Xml\ValidationResult
+     */
+    public static function validate(string $xml, array<string> $roots, ?Vector<ValueType> $types = null) : ValidationResult
+    {
+        \libxml_use_internal_errors(true);
+        \libxml_clear_errors();
+
+        $maxDepth = Config::getMaxDepth();
+
+        $reader = new XMLReader();
+
+        if ( ! $reader->XML($xml, null, Config::getParseOptions() | \LIBXML_NONET)) {
+            return static::fail($reader, 'Unable to read the document.', Vector{}, Vector{});
+        }
+
+        // The open elements, their position into the parent and their children.
+        $names = Vector{};
+        $positions = Vector{};
+        $children = Vector{};
+        $text = '';
+        $valueDepth = 0;
+        $paramPosition = -1;
+        $skip = 0;
+
+        while (true) {
+            try {
+                $read = $reader->read();
+            } catch (\Exception $e) {
+                return static::fail($reader, $e->getMessage(), $names, $positions);
+            }
+
+            if ( ! $read) {
+                break;
+            }
+
+            $nodeType = $reader->nodeType;
+
+            // Inside a custom type, only the nesting is followed.
+            if ($skip > 0) {
+                if ($nodeType === XMLReader::ELEMENT && ! $reader->isEmptyElement) {
+                    $skip++;
+                } else if ($nodeType === XMLReader::END_ELEMENT) {
+                    $skip--;
+                }
+
+                continue;
+            }
+
+            if ($nodeType === XMLReader::WHITESPACE || $nodeType === XMLReader::SIGNIFICANT_WHITESPACE) {
+                if (static::isLeaf($names->lastValue())) {
+                    $text .= $reader->value;
+                }
+
+                continue;
+            }
+
+            if ($nodeType === XMLReader::TEXT || $nodeType === XMLReader::CDATA) {
+                if ( ! static::isLeaf($names->lastValue())) {
+                    return static::fail($reader, 'Unexpected text.', $names, $positions);
+                }
+
+                $text .= $reader->value;
+
+                continue;
+            }
+
+            if ($nodeType === XMLReader::END_ELEMENT) {
+                $siblings = $children->lastValue() ?? Map{};
+                $error = static::close($names->lastValue() ?? '', $siblings, $text);
+
+                if ($error === null && $types !== null && static::isTopLevelValue($names)) {
+                    $error = static::checkType($types->get($paramPosition), $siblings);
+                }
+
+                if ($error !== null) {
+                    return static::fail($reader, $error, $names, $positions);
+                }
+
+                if ($names->pop() === Value::TAG_NAME) {
+                    $valueDepth--;
+                }
+
+                $positions->pop();
+                $children->pop();
+                $text = '';
+
+                continue;
+            }
+
+            if ($nodeType !== XMLReader::ELEMENT) {
+                continue;
+            }
+
+            $name = $reader->localName;
+            $parent = $names->lastValue();
+            $position = 1;
+
+            if ($parent === null) {
+                if ( ! \in_array($name, $roots, true)) {
+                    return static::fail($reader, \sprintf('Unexpected root "%s".', $name), $names, $positions);
+                }
+            } else {
+                $siblings = $children->at($children->count() - 1);
+                $error = static::open($parent, $name, $siblings);
+
+                if ($error !== null) {
+                    return static::fail($reader, $error, $names, $positions);
+                }
+
+                $position = ($siblings->get($name) ?? 0) + 1;
+                $siblings->set($name, $position);
+            }
+
+            if ($name === Param::TAG_NAME && $parent === Params::TAG_NAME && $names->count() <= 2) {
+                $paramPosition = $position - 1;
+            }
+
+            if ($parent === Value::TAG_NAME) {
+                if ( ! static::isBuiltin($name)) {
+                    // Custom types are checked by their handlers on decode.
+                    $skip = $reader->isEmptyElement ? 0 : 1;
+
+                    continue;
+                }
+            }
+
+            $names->add($name);
+            $positions->add($position);
+            $children->add(Map{});
+            $text = '';
+
+            if ($name === Value::TAG_NAME && ++$valueDepth > $maxDepth) {
+                return static::fail(
+                    $reader,
+                    \sprintf('The values nesting exceeds the limit of %d.', $maxDepth),
+                    $names,
+                    $positions
+                );
+            }
+
+            if ($reader->isEmptyElement) {
+                $error = static::close($name, Map{}, '');
+
+                if ($error !== null) {
+                    return static::fail($reader, $error, $names, $positions);
+                }
+
+                if ($names->pop() === Value::TAG_NAME) {
+                    $valueDepth--;
+                }
+
+                $positions->pop();
+                $children->pop();
+            }
+        }
+
+        // The warnings do not make the document invalid.
+        if (static::getLastError() !== null) {
+            return static::fail($reader, 'Malformed document.', $names, $positions);
+        }
+
+        if ($names->isEmpty()) {
+            $reader->close();
+
+            return new ValidationResult();
+        }
+
+        return static::fail($reader, 'Unexpected end of document.', $names, $positions);
+    }
+
+    /**
+     * Check an element against its parent and its previous siblings.
+     *
+     * @param string $parent The parent element name.
+     * @param string $name The element name.
+     * @param Map<string, int> $siblings The previous siblings count, by name.
+     *
+     * @return ?string The error, null when the element is allowed.
+     */
+    private static function open(string $parent, string $name, Map<string, int> $siblings) : ?string
+    {
+        // A <value> with several type tags is decoded as a list.
+        if ($parent === Value::TAG_NAME) {
+            if ( ! static::isBuiltin($name) && TypeRegistry::getDecoder($name) === null) {
+                return \sprintf('Unsupported type "%s".', $name);
+            }
+
+            return null;
+        }
+
+        $allowed = static::CHILDREN[$parent] ?? [];
+
+        if ( ! \in_array($name, $allowed, true)) {
+            return \sprintf('Unexpected tag "%s" into "%s".', $name, $parent);
+        }
+
+        // Only <params>, <param>, <struct> and <data> hold repeated children.
+        $repeated = $parent === Params::TAG_NAME
+            || $parent === Param::TAG_NAME
+            || $parent === Struct::TAG_NAME
+            || $parent === 'data';
+
+        if ( ! $repeated && $siblings->containsKey($name)) {
+            return \sprintf('Duplicated tag "%s" into "%s".', $name, $parent);
+        }
+
+        if ($parent === MethodResponse::TAG_NAME && ! $siblings->isEmpty()) {
+            return 'A response holds either params or a fault.';
+        }
+
+        return null;
+    }
+
+    /**
+     * Check an element once its children were read.
+     *
+     * @param string $name The element name.
+     * @param Map<string, int> $children The children count, by name.
+     * @param string $text The element text, for the leaf elements.
+     *
+     * @return ?string The error, null when the element is complete.
+     */
+    private static function close(string $name, Map<string, int> $children, string $text) : ?string
+    {
+        $required = null;
+
+        switch ($name) {
+            case Value::TAG_NAME:
+                return $children->isEmpty() ? 'Value tag has no children.' : null;
+            case MethodCall::TAG_NAME:
+                $required = MethodName::TAG_NAME;
+                break;
+            case MethodResponse::TAG_NAME:
+                return $children->isEmpty() ? 'A response holds either params or a fault.' : null;
+            case Param::TAG_NAME:
+            case static::FAULT_TAG_NAME:
+                $required = Value::TAG_NAME;
+                break;
+            case ArrayData::TAG_NAME:
+                $required = ArrayData::DATA_TAG_NAME;
+                break;
+            case Member::TAG_NAME:
+                if ( ! $children->containsKey(static::NAME_TAG_NAME)) {
+                    return \sprintf('Tag "%s" not found into "%s" node.', static::NAME_TAG_NAME, $name);
+                }
+
+                $required = Value::TAG_NAME;
+                break;
+            default:
+                return static::checkScalar($name, $text);
+        }
+
+        if ( ! $children->containsKey($required)) {
+            return \sprintf('Tag "%s" not found into "%s" node.', $required, $name);
+        }
+
+        return null;
+    }
+
+    /**
+     * Check a top level value against the expected param type.
+     *
+     * @param ?Ivyhjk\Xml\Contract\ValueType $expected
+     * @param Map<string, int> $children The type tags count, by name.
+     *
+     * @return ?string The error, null when the type matches.
+     */
+    private static function checkType(?ValueType $expected, Map<string, int> $children) : ?string
+    {
+        if ($expected === null || $children->isEmpty()) {
+            return null;
+        }
+
+        // Several type tags are decoded as a list.
+        $type = $children->count() === 1 && $children->firstValue() === 1
+            ? (string) $children->firstKey()
+            : ArrayData::TAG_NAME;
+
+        if (static::normalize($type) !== static::normalize((string) $expected)) {
+            return \sprintf('Expected "%s" and got "%s".', (string) $expected, $type);
+        }
+
+        return null;
+    }
+
+    /**
+     * Check the text of a scalar.
+     *
+     * @param string $type The scalar tag name.
+     * @param string $text
+     *
+     * @return ?string The error, null when the text is valid.
+     */
+    private static function checkScalar(string $type, string $text) : ?string
+    {
+        try {
+            switch ($type) {
+                case ValueType::INTEGER:
+                case ValueType::I8:
+                    Number::parseInt($text);
+                    break;
+                case ValueType::I4:
+                    Number::parseInt($text, 32);
+                    break;
+                case ValueType::FLOAT:
+                case ValueType::DOUBLE:
+                    Number::parseDouble($text);
+                    break;
+                case ValueType::DATETIME:
+                    // The lexemes accepted by the decoder.
+                    if (\preg_match(Timestamp::PATTERN, \trim($text)) !== 1) {
+                        return \sprintf('Invalid %s value: "%s"', Timestamp::TAG_NAME, $text);
+                    }
+                    break;
+                case ValueType::BASE64:
+                    if (\preg_match(static::BASE64_PATTERN, $text) !== 1) {
+                        return 'Invalid base64 value.';
+                    }
+                    break;
+            }
+        } catch (InvalidValueException $e) {
+            return $e->getMessage();
+        }
+
+        return null;
+    }
+
+    /**
+     * Check if an element holds text instead of elements.
+     *
+     * @param ?string $name
+     *
+     * @return bool
+     */
+    private static function isLeaf(?string $name) : bool
+    {
+        if ($name === null) {
+            return false;
+        }
+
+        return $name === MethodName::TAG_NAME
+            || $name === static::NAME_TAG_NAME
+            || ($name !== Struct::TAG_NAME && $name !== ArrayData::TAG_NAME && static::isBuiltin($name));
+    }
+
+    /**
+     * Check if a type tag is known by the library.
+     *
+     * @param string $name
+     *
+     * @return bool
+     */
+    private static function isBuiltin(string $name) : bool
+    {
+        return ValueType::isValid($name);
+    }
+
+    /**
+     * Check if the open elements end into a top level <value>.
+     *
+     * @param Vector<string> $names The open elements.
+     *
+     * @return bool
+     */
+    private static function isTopLevelValue(Vector<string> $names) : bool
+    {
+        $count = $names->count();
+
+        return ($count === 3 || $count === 4)
+            && $names->at($count - 1) === Value::TAG_NAME
+            && $names->at($count - 2) === Param::TAG_NAME
+            && $names->at($count - 3) === Params::TAG_NAME;
+    }
+
+    /**
+     * Group the type tags with the same meaning.
+     *
+     * @param string $type
+     *
+     * @return string
+     */
+    private static function normalize(string $type) : string
+    {
+        if ($type === ValueType::I4 || $type === ValueType::I8) {
+            return ValueType::INTEGER;
+        }
+
+        if ($type === ValueType::FLOAT) {
+            return ValueType::DOUBLE;
+        }
+
+        return $type;
+    }
+
+    /**
+     * Build a failed result at the current node.
+     *
+     * @param XMLReader $reader
+     * @param string $message
+     * @param Vector<string> $names The open elements.
+     * @param Vector<int> $positions Their positions.
+     *
+     * @return Ivyhjk\Xml\ValidationResult
+     */
+    private static function fail(
+        XMLReader $reader,
+        string $message,
+        Vector<string> $names,
+        Vector<int> $positions
+    ) : ValidationResult
+    {
+        $path = '';
+
+        foreach ($names as $index => $name) {
+            $path .= \sprintf('/%s[%d]', $name, $positions->at($index));
+        }
+
+        $line = 0;
+        $column = 0;
+        $error = static::getLastError();
+
+        if ($error !== null) {
+            $message = \trim($error->message);
+            $line = (int) $error->line;
+            $column = (int) $error->column;
+        } else {
+            // A grammar error, located at the current node, without column.
+            try {
+                $node = $reader->expand();
+            } catch (\Exception $e) {
+                $node = null;
+            }
+
+            if ($node instanceof \DOMNode) {
+                $line = (int) $node->getLineNo();
+            }
+        }
+
+        $reader->close();
+        \libxml_clear_errors();
+
+        return new ValidationResult($message, $path, $line, $column);
+    }
+
+    /**
+     * Get the last libxml error, leaving out the warnings.
+     *
+     * @return ?\LibXMLError
+     */
+    private static function getLastError() : ?\LibXMLError
+    {
+        $last = null;
+
+        foreach (\libxml_get_errors() as $error) {
+            if ($error->level >= \LIBXML_ERR_ERROR) {
+                $last = $error;
+            }
+        }
+
+        return $last;
+    }
+}
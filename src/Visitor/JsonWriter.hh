@@ -0,0 +1,340 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Visitor;
+
+use Ivyhjk\Xml\Number;
+use Ivyhjk\Xml\Writer;
+use Ivyhjk\Xml\Contract\Visitor;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Write JSON out of the walk events, into a string buffer or a stream.
+ *
+ * Structs are objects and arrays are arrays. The params are an array, a
+ * request is {"methodName": ..., "params": [...]} and a fault response is
+ * {"fault": {...}}. Dates and base64 are kept as their XML text.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Visitor
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class JsonWriter implements Visitor
+{
+    /**
+     * The json_encode flags of the strings.
+     *
+     * @var int
+     */
+    const int JSON_FLAGS = \JSON_UNESCAPED_SLASHES | \JSON_UNESCAPED_UNICODE;
+
+    /**
+     * The values written into each open container, innermost last.
+     *
+     * @var Vector<int>
+     */
+    private Vector<int> $counts = Vector{};
+
+    /**
+     * Whether each open container is an object, innermost last.
+     *
+     * @var Vector<bool>
+     */
+    private Vector<bool> $objects = Vector{};
+
+    /**
+     * Whether the document is a request.
+     *
+     * @var bool
+     */
+    private bool $request = false;
+
+    /**
+     * Whether the document is a fault response.
+     *
+     * @var bool
+     */
+    private bool $fault = false;
+
+    /**
+     * The output not written into the stream yet.
+     *
+     * @var string
+     */
+    private string $buffer = '';
+
+    /**
+     * Create a new JSON writer.
+     *
+     * @param ?resource $stream The output stream, null to keep the output in memory.
+     *
+     * @return void
+     */
+    public function __construct(private ?resource $stream = null) : void
+    {
+
+    }
+
+    /**
+     * Close the document, once the walk is done.
+     *
+     * @return void
+     */
+    public function finish() : void
+    {
+        if ($this->request) {
+            $this->write(']}');
+        } else if ($this->fault) {
+            $this->write('}');
+        } else if ($this->objects->isEmpty()) {
+            // A <params> without <param>.
+            $this->write('[]');
+        } else {
+            $this->write(']');
+        }
+
+        $this->flush();
+    }
+
+    /**
+     * Get the document, for the writers without stream.
+     *
+     * @return string
+     */
+    public function getOutput() : string
+    {
+        return $this->buffer;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onMethodName(string $name) : void
+    {
+        $this->request = true;
+
+        $this->write('{"methodName":' . static::encodeString($name) . ',"params":[');
+        $this->open(false);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onParamStart(int $index) : void
+    {
+        if ($this->objects->isEmpty()) {
+            $this->write('[');
+            $this->open(false);
+        }
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onParamEnd() : void
+    {
+
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onStructStart() : void
+    {
+        $this->startValue();
+        $this->write('{');
+        $this->open(true);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onMember(string $name) : void
+    {
+        $index = $this->counts->count() - 1;
+        $count = $this->counts->at($index);
+
+        $this->write(($count > 0 ? ',' : '') . static::encodeString($name) . ':');
+        $this->counts->set($index, $count + 1);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onStructEnd() : void
+    {
+        $this->close();
+        $this->write('}');
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onArrayStart() : void
+    {
+        $this->startValue();
+        $this->write('[');
+        $this->open(false);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onArrayEnd() : void
+    {
+        $this->close();
+        $this->write(']');
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onScalar(string $type, string $text) : void
+    {
+        switch ($type) {
+            case ValueType::INTEGER:
+            case ValueType::I8:
+                $json = (string) Number::parseInt($text);
+                break;
+            case ValueType::I4:
+                $json = (string) Number::parseInt($text, 32);
+                break;
+            case ValueType::FLOAT:
+            case ValueType::DOUBLE:
+                $json = Number::formatDouble(Number::parseDouble($text));
+
+                // Keep integral doubles as doubles when read back.
+                if (\strpbrk($json, '.E') === false) {
+                    $json .= '.0';
+                }
+                break;
+            case ValueType::BASE64:
+                $json = static::encodeString((string) \preg_replace('/\s+/', '', $text));
+                break;
+            default:
+                $json = static::encodeString($text);
+        }
+
+        $this->startValue();
+        $this->write($json);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onCustom(string $type, string $xml) : void
+    {
+        throw new UnsupportedValueType($type);
+    }
+
+    /**
+     * Write the separator before a value, a fault value opens the document.
+     *
+     * @return void
+     */
+    private function startValue() : void
+    {
+        if ($this->objects->isEmpty()) {
+            $this->fault = true;
+            $this->write('{"fault":');
+
+            return;
+        }
+
+        $index = $this->counts->count() - 1;
+
+        // Struct members write their own separator.
+        if ($this->objects->at($index)) {
+            return;
+        }
+
+        $count = $this->counts->at($index);
+
+        if ($count > 0) {
+            $this->write(',');
+        }
+
+        $this->counts->set($index, $count + 1);
+    }
+
+    /**
+     * Open a container.
+     *
+     * @param bool $object Whether it is an object.
+     *
+     * @return void
+     */
+    private function open(bool $object) : void
+    {
+        $this->objects->add($object);
+        $this->counts->add(0);
+    }
+
+    /**
+     * Close the innermost container.
+     *
+     * @return void
+     */
+    private function close() : void
+    {
+        $this->objects->pop();
+        $this->counts->pop();
+    }
+
+    /**
+     * Encode a JSON string.
+     *
+     * @param string $text UTF-8 text.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    private static function encodeString(string $text) : string
+    {
+        $json = \json_encode($text, static::JSON_FLAGS);
+
+        if ( ! \is_string($json)) {
+            throw new InvalidValueException('The text is not valid UTF-8.');
+        }
+
+        return $json;
+    }
+
+    /**
+     * Buffer output, flushing it into the stream when it grows.
+     *
+     * @param string $output
+     *
+     * @return void
+     */
+    private function write(string $output) : void
+    {
+        $this->buffer .= $output;
+
+        if ($this->stream !== null && \strlen($this->buffer) >= Writer::FLUSH_SIZE) {
+            $this->flush();
+        }
+    }
+
+    /**
+     * Write the buffered output into the stream.
+     *
+     * @return void
+     */
+    private function flush() : void
+    {
+        $stream = $this->stream;
+
+        if ($stream === null || $this->buffer === '') {
+            return;
+        }
+
+        \fwrite($stream, $this->buffer);
+
+        $this->buffer = '';
+    }
+}
@@ -0,0 +1,244 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Visitor;
+
+use SimpleXMLElement;
+use Ivyhjk\Xml\Caster;
+use Ivyhjk\Xml\TypeRegistry;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Contract\Visitor;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Build the same values as RPC::decode out of the walk events.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Visitor
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class ValueBuilder implements Visitor
+{
+    /**
+     * The request method name, if any.
+     *
+     * @var ?string
+     */
+    private ?string $methodName = null;
+
+    /**
+     * The decoded params.
+     *
+     * @var Vector<mixed>
+     */
+    private Vector<mixed> $params = Vector{};
+
+    /**
+     * The values of the current param.
+     *
+     * @var Vector<mixed>
+     */
+    private Vector<mixed> $paramValues = Vector{};
+
+    /**
+     * The open arrays items, a null entry for each open struct.
+     *
+     * @var Vector<?Vector<mixed>>
+     */
+    private Vector<?Vector<mixed>> $lists = Vector{};
+
+    /**
+     * The open structs members, a null entry for each open array.
+     *
+     * @var Vector<?Map<string, mixed>>
+     */
+    private Vector<?Map<string, mixed>> $structs = Vector{};
+
+    /**
+     * The member names waiting for their values.
+     *
+     * @var Vector<string>
+     */
+    private Vector<string> $memberNames = Vector{};
+
+    /**
+     * Create a new builder.
+     *
+     * @param Ivyhjk\Xml\Contract\OutputMode $mode The containers to use.
+     *
+     * @return void
+     */
+    public function __construct(private OutputMode $mode = OutputMode::COLLECTION) : void
+    {
+
+    }
+
+    /**
+     * Get the decoded params: the only param, or the list of them.
+     *
+     * @return mixed
+     */
+    public function getResult() : mixed
+    {
+        if ($this->params->count() === 1) {
+            return $this->params->firstValue();
+        }
+
+        return Value::toList($this->params, $this->mode);
+    }
+
+    /**
+     * Get the decoded params, always as a list.
+     *
+     * @return mixed
+     */
+    public function getParams() : mixed
+    {
+        return Value::toList($this->params, $this->mode);
+    }
+
+    /**
+     * Get the request method name.
+     *
+     * @return ?string
+     */
+    public function getMethodName() : ?string
+    {
+        return $this->methodName;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onMethodName(string $name) : void
+    {
+        $this->methodName = $name;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onParamStart(int $index) : void
+    {
+        $this->paramValues = Vector{};
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onParamEnd() : void
+    {
+        if ($this->paramValues->count() === 1) {
+            $this->params->add($this->paramValues->firstValue());
+        } else {
+            $this->params->add(Value::toList($this->paramValues, $this->mode));
+        }
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onStructStart() : void
+    {
+        $this->structs->add(Map{});
+        $this->lists->add(null);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onMember(string $name) : void
+    {
+        $this->memberNames->add($name);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onStructEnd() : void
+    {
+        $this->lists->pop();
+        $members = $this->structs->pop();
+
+        invariant($members !== null, 'A struct is open.');
+
+        $this->add($this->mode === OutputMode::HACK_ARRAY ? dict($members) : $members);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onArrayStart() : void
+    {
+        $this->lists->add(Vector{});
+        $this->structs->add(null);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onArrayEnd() : void
+    {
+        $this->structs->pop();
+        $items = $this->lists->pop();
+
+        invariant($items !== null, 'An array is open.');
+
+        $this->add(Value::toList($items, $this->mode));
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onScalar(string $type, string $text) : void
+    {
+        $this->add(Caster::castText($type, $text));
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function onCustom(string $type, string $xml) : void
+    {
+        $handler = TypeRegistry::getDecoder($type);
+
+        if ($handler === null) {
+            throw new XmlException('Unsuported cast type!.');
+        }
+
+        $this->add($handler->decode(new SimpleXMLElement($xml)));
+    }
+
+    /**
+     * Add a value into the open container, or into the current param.
+     *
+     * @param mixed $value
+     *
+     * @return void
+     */
+    private function add(mixed $value) : void
+    {
+        if ($this->lists->isEmpty()) {
+            $this->paramValues->add($value);
+
+            return;
+        }
+
+        $items = $this->lists->lastValue();
+
+        if ($items !== null) {
+            $items->add($value);
+
+            return;
+        }
+
+        $members = $this->structs->lastValue();
+
+        invariant($members !== null, 'A container is open.');
+
+        $members->set($this->memberNames->pop(), $value);
+    }
+}
@@ -0,0 +1,282 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use XMLReader;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Param;
+use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Entity\MethodName;
+use Ivyhjk\Xml\Contract\Visitor;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Stream a document into a visitor, without building entities nor values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Walker
+{
+    /**
+     * The parts of a member, as bits.
+     *
+     * @var int
+     */
+    const int MEMBER_NAME = 1;
+    const int MEMBER_VALUE = 2;
+
+    /**
+     * Walk a <params>, <methodResponse> or <methodCall> document.
+     *
+     * @param mixed $input The document, as a string or a readable stream.
+     *  A stream is read in chunks from its current position.
+     * @param Ivyhjk\Xml\Contract\Visitor $visitor
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    public static function walk(mixed $input, Visitor $visitor) : void
+    {
+        \libxml_use_internal_errors(true);
+        \libxml_clear_errors();
+
+        $reader = new XMLReader();
+
+        if (\is_string($input)) {
+            if ( ! $reader->XML($input, null, Config::getParseOptions() | \LIBXML_NONET)) {
+                throw new XmlException('Unable to read the document.');
+            }
+
+            static::read($reader, $visitor);
+
+            return;
+        }
+
+        if ( ! \is_resource($input) || \get_resource_type($input) !== 'stream') {
+            throw new XmlException('A string or a readable stream was expected.');
+        }
+
+        $uri = StreamWrapper::expose($input);
+
+        try {
+            if ( ! $reader->open($uri, null, Config::getParseOptions() | \LIBXML_NONET)) {
+                throw new XmlException('Unable to read the document.');
+            }
+
+            static::read($reader, $visitor);
+        } finally {
+            StreamWrapper::release($uri);
+        }
+    }
+
+    /**
+     * Read an opened document into the visitor.
+     *
+     * @param XMLReader $reader
+     * @param Ivyhjk\Xml\Contract\Visitor $visitor
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\XmlException
+     */
+    private static function read(XMLReader $reader, Visitor $visitor) : void
+    {
+        $maxDepth = Config::getMaxDepth();
+
+        $names = Vector{};
+        // The parts read of each open member: MEMBER_NAME and MEMBER_VALUE bits.
+        $members = Vector{};
+        $paramIndex = 0;
+        $valueDepth = 0;
+        $typed = true;
+        $advance = true;
+
+        while ( ! $advance || $reader->read()) {
+            $advance = true;
+            $nodeType = $reader->nodeType;
+
+            if ($nodeType === XMLReader::END_ELEMENT) {
+                $name = $names->pop();
+
+                if ($name === Value::TAG_NAME) {
+                    $valueDepth--;
+                } else if ($name === Member::TAG_NAME) {
+                    static::closeMember($members->pop());
+                }
+
+                static::close($name, $names->lastValue(), $typed, $visitor);
+
+                continue;
+            }
+
+            if ($nodeType !== XMLReader::ELEMENT) {
+                continue;
+            }
+
+            $name = $reader->localName;
+            $parent = $names->lastValue();
+
+            if ($parent === Value::TAG_NAME) {
+                $typed = true;
+
+                if ($name !== Struct::TAG_NAME && $name !== ArrayData::TAG_NAME) {
+                    if (ValueType::isValid($name)) {
+                        $visitor->onScalar($name, $reader->readString());
+                    } else {
+                        $visitor->onCustom($name, $reader->readOuterXml());
+                    }
+
+                    // Continue after the scalar, its text was already read.
+                    if ( ! $reader->next()) {
+                        break;
+                    }
+
+                    $advance = false;
+
+                    continue;
+                }
+            }
+
+            if ($name === MethodName::TAG_NAME || ($name === 'name' && $parent === Member::TAG_NAME)) {
+                if ($name === MethodName::TAG_NAME) {
+                    $visitor->onMethodName($reader->readString());
+                } else {
+                    static::addMemberPart($members, self::MEMBER_NAME);
+
+                    $visitor->onMember($reader->readString());
+                }
+
+                if ( ! $reader->next()) {
+                    break;
+                }
+
+                $advance = false;
+
+                continue;
+            }
+
+            if ($name === Value::TAG_NAME) {
+                if (++$valueDepth > $maxDepth) {
+                    throw new DepthLimitExceeded($maxDepth);
+                }
+
+                if ($parent === Member::TAG_NAME) {
+                    static::addMemberPart($members, self::MEMBER_VALUE);
+                }
+
+                $typed = false;
+            } else if ($name === Member::TAG_NAME) {
+                $members->add(0);
+            } else if ($name === Struct::TAG_NAME) {
+                $visitor->onStructStart();
+            } else if ($name === ArrayData::TAG_NAME) {
+                $visitor->onArrayStart();
+            } else if ($name === Param::TAG_NAME && $parent === Params::TAG_NAME) {
+                $visitor->onParamStart($paramIndex++);
+            }
+
+            if ($reader->isEmptyElement) {
+                if ($name === Value::TAG_NAME) {
+                    $valueDepth--;
+                } else if ($name === Member::TAG_NAME) {
+                    static::closeMember($members->pop());
+                }
+
+                static::close($name, $parent, $typed, $visitor);
+            } else {
+                $names->add($name);
+            }
+        }
+
+        $error = \libxml_get_last_error();
+
+        $reader->close();
+
+        if ($error) {
+            \libxml_clear_errors();
+
+            throw new XmlException(\trim($error->message));
+        }
+
+        if ( ! $names->isEmpty()) {
+            throw new XmlException(\sprintf('Unclosed tag "%s".', $names->lastValue()));
+        }
+    }
+
+    /**
+     * Mark a part of the innermost member as read, the name must come
+     * first and each part only once.
+     *
+     * @param Vector<int> $members The parts read of each open member.
+     * @param int $part MEMBER_NAME or MEMBER_VALUE.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    private static function addMemberPart(Vector<int> $members, int $part) : void
+    {
+        $index = $members->count() - 1;
+        $parts = $members->at($index);
+
+        if ($parts & $part) {
+            throw new InvalidNodeException('A member has more than one name or value.');
+        }
+
+        if ($part === self::MEMBER_VALUE && ! ($parts & self::MEMBER_NAME)) {
+            throw new InvalidNodeException('A member value comes before its name.');
+        }
+
+        $members->set($index, $parts | $part);
+    }
+
+    /**
+     * Check that a closed member had its name and its value.
+     *
+     * @param int $parts The parts read of the member.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    private static function closeMember(int $parts) : void
+    {
+        if ($parts !== (self::MEMBER_NAME | self::MEMBER_VALUE)) {
+            throw new InvalidNodeException('A member must have one name and one value.');
+        }
+    }
+
+    /**
+     * Notify the end of an element.
+     *
+     * @param string $name The element name.
+     * @param ?string $parent The parent element name.
+     * @param bool $typed Whether the last <value> had a type element.
+     * @param Ivyhjk\Xml\Contract\Visitor $visitor
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\InvalidNodeException
+     */
+    private static function close(string $name, ?string $parent, bool $typed, Visitor $visitor) : void
+    {
+        if ($name === Value::TAG_NAME && ! $typed) {
+            throw new InvalidNodeException('Value tag has no children.');
+        }
+
+        if ($name === Struct::TAG_NAME) {
+            $visitor->onStructEnd();
+        } else if ($name === ArrayData::TAG_NAME) {
+            $visitor->onArrayEnd();
+        } else if ($name === Param::TAG_NAME && $parent === Params::TAG_NAME) {
+            $visitor->onParamEnd();
+        }
+    }
+}
@@ -0,0 +1,943 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml;
+
+use DOMDocument;
+use DateTimeInterface;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\Param;
+use Ivyhjk\Xml\Entity\Params;
+use Ivyhjk\Xml\Entity\Member;
+use Ivyhjk\Xml\Entity\Struct;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Entity\MethodCall;
+use Ivyhjk\Xml\Entity\MethodName;
+use Ivyhjk\Xml\Entity\MethodResponse;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Type\Placeholder;
+use Ivyhjk\Xml\Type\PlaceholderHandler;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\TypeHandler;
+use Ivyhjk\Xml\Metadata\MetadataCache;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Exception\InvalidStateException;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Write an XML RPC document event by event, into a string buffer or a
+ * stream, without building values nor DOM nodes.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Writer
+{
+    /**
+     * The open elements kinds.
+     *
+     * @var int
+     */
+    const int FRAME_METHOD_CALL = 0;
+    const int FRAME_METHOD_RESPONSE = 1;
+    const int FRAME_PARAMS = 2;
+    const int FRAME_STRUCT = 3;
+    const int FRAME_MEMBER = 4;
+    const int FRAME_ARRAY = 5;
+    const int FRAME_FRAGMENT = 6;
+
+    /**
+     * The fragment cache keys prefix of the written values.
+     *
+     * @var string
+     */
+    const string FRAGMENT_PREFIX = 'writer.';
+
+    /**
+     * The buffered bytes written at once into the stream.
+     *
+     * @var int
+     */
+    const int FLUSH_SIZE = 65536;
+
+    /**
+     * The open elements, innermost last.
+     *
+     * @var Vector<int>
+     */
+    private Vector<int> $frames = Vector{};
+
+    /**
+     * The nesting level of the next value, its <value> element included
+     * (one per open array or member, as Value counts it).
+     *
+     * @var int
+     */
+    private int $depth = 1;
+
+    /**
+     * The output not written into the stream yet.
+     *
+     * @var string
+     */
+    private string $buffer = '';
+
+    /**
+     * Whether the root element was written.
+     *
+     * @var bool
+     */
+    private bool $started = false;
+
+    /**
+     * Whether the output is canonical: sorted members, no optional whitespace.
+     *
+     * @var bool
+     */
+    private bool $canonical = false;
+
+    /**
+     * Whether the written values are looked up into the fragment cache, a
+     * fragment being written does not look up its own children.
+     *
+     * @var bool
+     */
+    private bool $cacheable = true;
+
+    /**
+     * The last member name of each open struct, checked in canonical mode.
+     *
+     * @var Vector<?string>
+     */
+    private Vector<?string> $memberNames = Vector{};
+
+    /**
+     * The hash context fed with the output, if any.
+     *
+     * @var ?resource
+     */
+    private ?resource $hashContext = null;
+
+    /**
+     * The final hash, once computed.
+     *
+     * @var ?string
+     */
+    private ?string $hash = null;
+
+    /**
+     * Whether the output is kept (it is dropped when only the hash is wanted).
+     *
+     * @var bool
+     */
+    private bool $keepOutput = true;
+
+    /**
+     * Create a new writer.
+     *
+     * @param ?resource $stream The output stream, null to keep the output in memory.
+     * @param string $encoding The XML encoding.
+     *
+     * @return void
+     */
+    public function __construct(private ?resource $stream = null, private string $encoding = 'utf-8') : void
+    {
+
+    }
+
+    /**
+     * Write the canonical form of the values: struct members sorted by name,
+     * numbers in their shortest form and no optional whitespace. Members
+     * written with member() must come in order.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function canonical() : this
+    {
+        if ($this->started) {
+            throw new InvalidStateException('The output mode must be set before writing.');
+        }
+
+        $this->canonical = true;
+
+        return $this;
+    }
+
+    /**
+     * Hash the output while it is written.
+     *
+     * @param string $algorithm A hash_algos() algorithm.
+     * @param bool $keepOutput Whether the output is kept too, for getOutput() or the stream.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function hashWith(string $algorithm = 'sha256', bool $keepOutput = true) : this
+    {
+        if ($this->started) {
+            throw new InvalidStateException('The hash must be set before writing.');
+        }
+
+        $this->hashContext = \hash_init($algorithm);
+        $this->keepOutput = $keepOutput;
+
+        return $this;
+    }
+
+    /**
+     * Get the hash of the complete output.
+     *
+     * @return string The lowercase hexadecimal hash.
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function getHash() : string
+    {
+        if ($this->hash !== null) {
+            return $this->hash;
+        }
+
+        $context = $this->hashContext;
+
+        if ($context === null) {
+            throw new InvalidStateException('The output is not hashed, see hashWith().');
+        }
+
+        if ( ! $this->isComplete()) {
+            throw new InvalidStateException('The document has open elements.');
+        }
+
+        $this->hash = \hash_final($context);
+
+        return $this->hash;
+    }
+
+    /**
+     * Open a <methodCall>, its params come next.
+     *
+     * @param string $method The method name.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function startMethodCall(string $method) : this
+    {
+        $this->startRoot();
+
+        $this->write(\sprintf(
+            '<%1$s><%2$s>%3$s</%2$s>',
+            MethodCall::TAG_NAME,
+            MethodName::TAG_NAME,
+            $this->escape($method)
+        ));
+
+        $this->frames->add(static::FRAME_METHOD_CALL);
+
+        return $this;
+    }
+
+    /**
+     * Open a <methodResponse>, its params come next.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function startMethodResponse() : this
+    {
+        $this->startRoot();
+
+        $this->write('<' . MethodResponse::TAG_NAME . '>');
+
+        $this->frames->add(static::FRAME_METHOD_RESPONSE);
+
+        return $this;
+    }
+
+    /**
+     * Open the <params>, each value written into them is a <param>.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function startParams() : this
+    {
+        $frame = $this->frames->lastValue();
+
+        if ($frame === null) {
+            $this->startRoot();
+        } else if ($frame !== static::FRAME_METHOD_CALL && $frame !== static::FRAME_METHOD_RESPONSE) {
+            throw new InvalidStateException('Params are only allowed at the root or into a method call or response.');
+        }
+
+        $this->write('<' . Params::TAG_NAME . '>');
+
+        $this->frames->add(static::FRAME_PARAMS);
+
+        return $this;
+    }
+
+    /**
+     * Open a <struct> value.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function startStruct() : this
+    {
+        $this->startValue();
+
+        $this->write('<' . Struct::TAG_NAME . '>');
+
+        $this->frames->add(static::FRAME_STRUCT);
+        $this->memberNames->add(null);
+
+        return $this;
+    }
+
+    /**
+     * Open a <member> of the current struct, its value comes next.
+     *
+     * @param string $name The member name.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function member(string $name) : this
+    {
+        if ($this->frames->lastValue() !== static::FRAME_STRUCT) {
+            throw new InvalidStateException('Members are only allowed into a struct.');
+        }
+
+        if ($this->canonical) {
+            $previous = $this->memberNames->lastValue();
+
+            if ($previous !== null && \strcmp($previous, $name) >= 0) {
+                throw new InvalidStateException(\sprintf('Member "%s" is out of the canonical order.', $name));
+            }
+
+            $this->memberNames->set($this->memberNames->count() - 1, $name);
+        }
+
+        $this->write(\sprintf('<%s><name>%s</name>', Member::TAG_NAME, $this->escape($name)));
+
+        $this->frames->add(static::FRAME_MEMBER);
+        $this->depth++;
+
+        return $this;
+    }
+
+    /**
+     * Open an <array> value.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function startArray() : this
+    {
+        $this->startValue();
+
+        $this->write('<' . ArrayData::TAG_NAME . '><' . ArrayData::DATA_TAG_NAME . '>');
+
+        $this->frames->add(static::FRAME_ARRAY);
+        $this->depth++;
+
+        return $this;
+    }
+
+    /**
+     * Close the innermost open element.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function end() : this
+    {
+        if ($this->frames->isEmpty()) {
+            throw new InvalidStateException('There is nothing to close.');
+        }
+
+        switch ($this->frames->pop()) {
+            case static::FRAME_METHOD_CALL:
+                $this->write('</' . MethodCall::TAG_NAME . '>');
+                break;
+            case static::FRAME_METHOD_RESPONSE:
+                $this->write('</' . MethodResponse::TAG_NAME . '>');
+                break;
+            case static::FRAME_PARAMS:
+                $this->write('</' . Params::TAG_NAME . '>');
+                break;
+            case static::FRAME_STRUCT:
+                $this->memberNames->pop();
+                $this->write('</' . Struct::TAG_NAME . '>');
+                $this->endValue();
+                break;
+            case static::FRAME_ARRAY:
+                $this->depth--;
+                $this->write('</' . ArrayData::DATA_TAG_NAME . '></' . ArrayData::TAG_NAME . '>');
+                $this->endValue();
+                break;
+            default:
+                throw new InvalidStateException('A member can not be closed before its value.');
+        }
+
+        if ($this->frames->isEmpty()) {
+            if ( ! $this->canonical) {
+                $this->write("\n");
+            }
+
+            $this->flush();
+        }
+
+        return $this;
+    }
+
+    /**
+     * Write an <int> value.
+     *
+     * @param int $value
+     *
+     * @return this
+     */
+    public function int(int $value) : this
+    {
+        return $this->scalar(ValueType::INTEGER, (string) $value);
+    }
+
+    /**
+     * Write a <double> value.
+     *
+     * @param float $value
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException
+     */
+    public function double(float $value) : this
+    {
+        // Canonical zero has no sign.
+        if ($this->canonical && $value == 0.0) {
+            return $this->scalar(ValueType::DOUBLE, '0');
+        }
+
+        return $this->scalar(ValueType::DOUBLE, Number::formatDouble($value));
+    }
+
+    /**
+     * Write a <string> value.
+     *
+     * @param string $value
+     *
+     * @return this
+     */
+    public function string(string $value) : this
+    {
+        return $this->scalar(ValueType::STRING, $this->escape($value));
+    }
+
+    /**
+     * Write a <dateTime.iso8601> value.
+     *
+     * @param mixed $value A Timestamp or a DateTimeInterface.
+     *
+     * @return this
+     */
+    public function dateTime(mixed $value) : this
+    {
+        if ($value instanceof DateTimeInterface) {
+            $value = Timestamp::fromDateTime($value);
+        }
+
+        if ( ! $value instanceof Timestamp) {
+            throw new UnsupportedValueType(\gettype($value));
+        }
+
+        return $this->scalar(ValueType::DATETIME, $this->escape($value->getLexeme()));
+    }
+
+    /**
+     * Write a <base64> value, chunk by chunk.
+     *
+     * @param Ivyhjk\Xml\Type\Base64 $value
+     *
+     * @return this
+     */
+    public function base64(Base64 $value) : this
+    {
+        $this->startValue();
+
+        $this->write('<' . ValueType::BASE64 . '>');
+
+        foreach ($value->encode() as $chunk) {
+            $this->write($chunk);
+        }
+
+        $this->write('</' . ValueType::BASE64 . '>');
+
+        $this->endValue();
+
+        return $this;
+    }
+
+    /**
+     * Write a native value with the rules of the DOM encoder (see
+     * Value::getElement): scalars, registered types, lists as arrays,
+     * dates, base64, keyed containers and plain objects as structs.
+     *
+     * @param mixed $value
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    public function value(mixed $value) : this
+    {
+        return $this->writeValue($value, $this->cacheable);
+    }
+
+    /**
+     * Write a native value, from the fragment cache when it is cacheable.
+     *
+     * @param mixed $value
+     * @param bool $cacheable Whether the fragment cache may be used.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    private function writeValue(mixed $value, bool $cacheable) : this
+    {
+        if (\is_int($value)) {
+            return $this->int($value);
+        }
+
+        if (\is_string($value)) {
+            return $this->string($value);
+        }
+
+        if (\is_float($value)) {
+            return $this->double($value);
+        }
+
+        if ($cacheable && FragmentCache::isEnabled()) {
+            $key = FragmentCache::getKey($value);
+
+            if ($key !== null) {
+                return $this->writeCached($value, $key);
+            }
+        }
+
+        // Template slots, then application objects with a registered handler.
+        if ($value instanceof Placeholder) {
+            return $this->custom(new PlaceholderHandler(), $value);
+        }
+
+        $handler = TypeRegistry::getEncoder($value);
+
+        if ($handler !== null) {
+            return $this->custom($handler, $value);
+        }
+
+        if ($value instanceof TypedList) {
+            return $this->typedList($value);
+        }
+
+        if (Value::isList($value)) {
+            invariant($value instanceof Traversable, 'Lists are traversable.');
+
+            $this->startArray();
+
+            foreach ($value as $item) {
+                $this->value($item);
+            }
+
+            return $this->end();
+        }
+
+        if ($value instanceof Timestamp || $value instanceof DateTimeInterface) {
+            return $this->dateTime($value);
+        }
+
+        if ($value instanceof Base64) {
+            return $this->base64($value);
+        }
+
+        if (\is_resource($value) && \get_resource_type($value) === 'stream') {
+            return $this->base64(Base64::fromStream($value));
+        }
+
+        // Dicts, keyed collections, sets and the other PHP arrays.
+        if ($value instanceof KeyedTraversable) {
+            return $this->struct($value);
+        }
+
+        if ( ! \is_object($value) || $value instanceof \Closure) {
+            throw new UnsupportedValueType(\gettype($value));
+        }
+
+        // Plain objects: the public properties, described once per class.
+        $properties = \get_object_vars($value);
+        $members = Map{};
+
+        foreach (MetadataCache::get(\get_class($value))->getNames() as $name) {
+            // Unset properties, and null as XML RPC has no null.
+            if (($properties[$name] ?? null) !== null) {
+                $members->set($name, $properties[$name]);
+            }
+        }
+
+        return $this->struct($members);
+    }
+
+    /**
+     * Write a struct out of its members, sorted in canonical mode.
+     *
+     * @param KeyedTraversable<mixed, mixed> $members The values by member name.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\InvalidValueException When two names are
+     *  the same text in canonical mode, ex: 1 and '1'.
+     */
+    private function struct(KeyedTraversable<mixed, mixed> $members) : this
+    {
+        $this->startStruct();
+
+        if ($this->canonical) {
+            $sorted = [];
+
+            foreach ($members as $name => $item) {
+                $name = (string) $name;
+
+                // Keeping either one would hash different values the same.
+                if (\array_key_exists($name, $sorted)) {
+                    throw new InvalidValueException(\sprintf('Duplicate member "%s".', $name));
+                }
+
+                $sorted[$name] = $item;
+            }
+
+            \ksort($sorted, \SORT_STRING);
+
+            $members = $sorted;
+        }
+
+        foreach ($members as $name => $item) {
+            $this->member((string) $name)->value($item);
+        }
+
+        return $this->end();
+    }
+
+    /**
+     * Write a list whose items share a declared type, the scalars are
+     * written with that type whatever their native type is.
+     *
+     * @param Ivyhjk\Xml\Type\TypedList $list
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\UnsupportedValueType
+     */
+    private function typedList(TypedList $list) : this
+    {
+        $type = $list->getType();
+        $names = null;
+
+        $this->startArray();
+
+        foreach ($list->getItems() as $item) {
+            if ($type === ValueType::ARRAY) {
+                $this->value($item);
+            } else if ($type === ValueType::STRUCT) {
+                if ( ! $item instanceof KeyedTraversable) {
+                    throw new UnsupportedValueType(\gettype($item));
+                }
+
+                // The first item defines the layout, as Value::appendStructs does.
+                $itemNames = Vector{};
+
+                foreach ($item as $memberName => $memberValue) {
+                    $itemNames->add((string) $memberName);
+                }
+
+                if ($names === null) {
+                    $names = $itemNames;
+                } else if ($itemNames->toArray() !== $names->toArray()) {
+                    throw new XmlException('All the structs of the list must have the same members.');
+                }
+
+                $this->struct($item);
+            } else if ($type === ValueType::FLOAT || $type === ValueType::DOUBLE) {
+                $this->double((float) $item);
+            } else {
+                $this->scalar((string) $type, $this->escape(TypedList::toText($type, $item)));
+            }
+        }
+
+        return $this->end();
+    }
+
+    /**
+     * Write a value through its type handler. The handler fills a scratch
+     * <value> element, whose children are copied as XML.
+     *
+     * @param Ivyhjk\Xml\Contract\TypeHandler $handler
+     * @param mixed $value
+     *
+     * @return this
+     */
+    private function custom(TypeHandler $handler, mixed $value) : this
+    {
+        // No document encoding: the non ASCII text is written as character references.
+        $document = new DOMDocument();
+        $valueElement = $document->createElement(Value::TAG_NAME);
+
+        $handler->encode($value, $valueElement);
+
+        $this->startValue();
+
+        foreach ($valueElement->childNodes as $child) {
+            $this->write((string) $document->saveXML($child));
+        }
+
+        $this->endValue();
+
+        return $this;
+    }
+
+    /**
+     * Write a cacheable value from the fragment cache, or write it whole
+     * and keep it there.
+     *
+     * @param mixed $value
+     * @param string $key The fragment cache key of the value.
+     *
+     * @return this
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    private function writeCached(mixed $value, string $key) : this
+    {
+        $key = static::FRAGMENT_PREFIX
+            . ($this->canonical ? 'canonical.' : '')
+            . \strtolower($this->encoding) . '.' . $key;
+        $entry = FragmentCache::get($key);
+
+        if ($entry === null) {
+            $writer = new Writer(null, $this->encoding);
+            $writer->canonical = $this->canonical;
+            $writer->cacheable = false;
+            $writer->started = true;
+            $writer->frames->add(static::FRAME_FRAGMENT);
+            $writer->writeValue($value, false);
+
+            $fragment = $writer->buffer;
+            $height = FragmentCache::measure($fragment);
+
+            FragmentCache::set($key, $fragment, $height);
+        } else {
+            list($fragment, $height) = $entry;
+        }
+
+        // The fragment is measured from its own root, and may be reused at
+        // another level: the same check on a miss and on a hit.
+        if ($this->getDepth() + $height > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        $this->startValue();
+        $this->write($fragment);
+        $this->endValue();
+
+        return $this;
+    }
+
+    /**
+     * Get the nesting level of the next value, its <value> element included.
+     *
+     * @return int
+     */
+    private function getDepth() : int
+    {
+        return $this->depth;
+    }
+
+    /**
+     * Check if every open element was closed.
+     *
+     * @return bool
+     */
+    public function isComplete() : bool
+    {
+        return $this->started && $this->frames->isEmpty();
+    }
+
+    /**
+     * Get the document, for the writers without stream.
+     *
+     * @return string
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    public function getOutput() : string
+    {
+        if ($this->stream !== null) {
+            throw new InvalidStateException('The output was written into the stream.');
+        }
+
+        if ( ! $this->isComplete()) {
+            throw new InvalidStateException('The document has open elements.');
+        }
+
+        return $this->buffer;
+    }
+
+    /**
+     * Write the buffered output into the stream.
+     *
+     * @return void
+     */
+    public function flush() : void
+    {
+        $stream = $this->stream;
+
+        if ($stream === null || $this->buffer === '') {
+            return;
+        }
+
+        \fwrite($stream, $this->buffer);
+
+        $this->buffer = '';
+    }
+
+    /**
+     * Write the XML declaration, once.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     */
+    private function startRoot() : void
+    {
+        if ($this->started) {
+            throw new InvalidStateException('The document already has a root element.');
+        }
+
+        $this->started = true;
+
+        $this->write(\sprintf(
+            '<?xml version="1.0" encoding="%s"?>%s',
+            $this->encoding,
+            $this->canonical ? '' : "\n"
+        ));
+    }
+
+    /**
+     * Write a scalar value.
+     *
+     * @param string $type The type tag name.
+     * @param string $text The escaped text.
+     *
+     * @return this
+     */
+    private function scalar(string $type, string $text) : this
+    {
+        $this->startValue();
+
+        $this->write(\sprintf('<%1$s>%2$s</%1$s>', $type, $text));
+
+        $this->endValue();
+
+        return $this;
+    }
+
+    /**
+     * Open the elements around a value, they depend on its container.
+     * Every value is checked against the depth limit, scalars included.
+     *
+     * @return void
+     * @throws Ivyhjk\Xml\Exception\InvalidStateException
+     * @throws Ivyhjk\Xml\Exception\DepthLimitExceeded
+     */
+    private function startValue() : void
+    {
+        if ($this->depth > Config::getMaxDepth()) {
+            throw new DepthLimitExceeded(Config::getMaxDepth());
+        }
+
+        switch ($this->frames->lastValue()) {
+            case static::FRAME_PARAMS:
+                $this->write('<' . Param::TAG_NAME . '><' . Value::TAG_NAME . '>');
+                break;
+            case static::FRAME_ARRAY:
+            case static::FRAME_MEMBER:
+                $this->write('<' . Value::TAG_NAME . '>');
+                break;
+            case static::FRAME_FRAGMENT:
+                // Only the type element is kept.
+                break;
+            default:
+                throw new InvalidStateException('Values are only allowed into params, arrays or members.');
+        }
+    }
+
+    /**
+     * Close the elements around a value.
+     *
+     * @return void
+     */
+    private function endValue() : void
+    {
+        switch ($this->frames->lastValue()) {
+            case static::FRAME_PARAMS:
+                $this->write('</' . Value::TAG_NAME . '></' . Param::TAG_NAME . '>');
+                break;
+            case static::FRAME_MEMBER:
+                $this->write('</' . Value::TAG_NAME . '></' . Member::TAG_NAME . '>');
+                $this->frames->pop();
+                $this->depth--;
+                break;
+            case static::FRAME_FRAGMENT:
+                break;
+            default:
+                $this->write('</' . Value::TAG_NAME . '>');
+        }
+    }
+
+    /**
+     * Escape a text node, the text is expected in the document encoding.
+     *
+     * @param string $text
+     *
+     * @return string
+     */
+    private function escape(string $text) : string
+    {
+        return \htmlspecialchars($text, \ENT_XML1 | \ENT_NOQUOTES | \ENT_SUBSTITUTE, $this->encoding);
+    }
+
+    /**
+     * Buffer output, flushing it into the stream when it grows.
+     *
+     * @param string $output
+     *
+     * @return void
+     */
+    private function write(string $output) : void
+    {
+        $context = $this->hashContext;
+
+        if ($context !== null) {
+            \hash_update($context, $output);
+
+            if ( ! $this->keepOutput) {
+                return;
+            }
+        }
+
+        $this->buffer .= $output;
+
+        if ($this->stream !== null && \strlen($this->buffer) >= static::FLUSH_SIZE) {
+            $this->flush();
+        }
+    }
+}
@@ -0,0 +1,37 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+/**
+ * A model built from its constructor.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Author
+{
+    /**
+     * The author email, not known by the constructor.
+     *
+     * @var ?string
+     */
+    public ?string $email = null;
+
+    /**
+     * Create a new author.
+     *
+     * @param int $id
+     * @param string $name
+     * @param string $role
+     *
+     * @return void
+     */
+    public function __construct(public int $id, public string $name, public string $role = 'writer') : void
+    {
+
+    }
+}
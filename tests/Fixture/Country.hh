@@ -0,0 +1,41 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+use Ivyhjk\Xml\Contract\CacheableValue;
+
+/**
+ * A tagged application value.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Country implements CacheableValue
+{
+    /**
+     * Create a new country.
+     *
+     * @param string $code
+     * @param string $name
+     *
+     * @return void
+     */
+    public function __construct(public string $code, public string $name) : void
+    {
+
+    }
+
+    /**
+     * Get the cache key, the country code.
+     *
+     * @return string
+     */
+    public function getCacheKey() : string
+    {
+        return $this->code;
+    }
+}
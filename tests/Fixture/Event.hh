@@ -0,0 +1,31 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+use DateTime;
+
+/**
+ * A model with a mutable date.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Event
+{
+    /**
+     * Create a new event.
+     *
+     * @param string $name
+     * @param DateTime $date
+     *
+     * @return void
+     */
+    public function __construct(public string $name, public DateTime $date) : void
+    {
+
+    }
+}
@@ -0,0 +1,29 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+/**
+ * An application value for the tests.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Money
+{
+    /**
+     * Create a new amount.
+     *
+     * @param int $cents
+     * @param string $currency
+     *
+     * @return void
+     */
+    public function __construct(public int $cents, public string $currency) : void
+    {
+
+    }
+}
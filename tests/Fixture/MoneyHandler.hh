@@ -0,0 +1,50 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+use DOMElement;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Contract\TypeHandler;
+
+/**
+ * Write Money values as <money currency="...">cents</money>.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class MoneyHandler implements TypeHandler
+{
+    /**
+     * Write a Money value into a <value> element.
+     *
+     * @param mixed $value
+     * @param DOMElement $valueElement
+     *
+     * @return void
+     */
+    public function encode(mixed $value, DOMElement $valueElement) : void
+    {
+        invariant($value instanceof Money, 'Money expected.');
+
+        $element = $valueElement->ownerDocument->createElement('money', (string) $value->cents);
+        $element->setAttribute('currency', $value->currency);
+
+        $valueElement->appendChild($element);
+    }
+
+    /**
+     * Read a Money value from a <money> node.
+     *
+     * @param SimpleXMLElement $node
+     *
+     * @return mixed
+     */
+    public function decode(SimpleXMLElement $node) : mixed
+    {
+        return new Money((int) (string) $node, (string) $node['currency']);
+    }
+}
@@ -0,0 +1,38 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+use DateTimeImmutable;
+
+/**
+ * A model with nested models.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Post
+{
+    /**
+     * Create a new post.
+     *
+     * @param string $title
+     * @param Ivyhjk\Xml\Test\Fixture\Author $author
+     * @param Vector<Ivyhjk\Xml\Test\Fixture\Author> $reviewers
+     * @param ?DateTimeImmutable $published
+     *
+     * @return void
+     */
+    public function __construct(
+        public string $title,
+        public Author $author,
+        public Vector<Author> $reviewers,
+        public ?DateTimeImmutable $published = null
+    ) : void
+    {
+
+    }
+}
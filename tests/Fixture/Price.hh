@@ -0,0 +1,18 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+/**
+ * A Money subclass, it must use the Money handler.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Price extends Money
+{
+
+}
@@ -0,0 +1,137 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+use Ivyhjk\Xml\Contract\Visitor;
+
+/**
+ * A visitor recording the walk events.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class RecordingVisitor implements Visitor
+{
+    /**
+     * The recorded events.
+     *
+     * @var Vector<string>
+     */
+    public Vector<string> $events = Vector{};
+
+    /**
+     * Record the method name.
+     *
+     * @param string $name
+     *
+     * @return void
+     */
+    public function onMethodName(string $name) : void
+    {
+        $this->events->add('method:' . $name);
+    }
+
+    /**
+     * Record the start of a param.
+     *
+     * @param int $index
+     *
+     * @return void
+     */
+    public function onParamStart(int $index) : void
+    {
+        $this->events->add('param:' . $index);
+    }
+
+    /**
+     * Record the end of a param.
+     *
+     * @return void
+     */
+    public function onParamEnd() : void
+    {
+        $this->events->add('/param');
+    }
+
+    /**
+     * Record the start of a struct.
+     *
+     * @return void
+     */
+    public function onStructStart() : void
+    {
+        $this->events->add('struct');
+    }
+
+    /**
+     * Record a member name.
+     *
+     * @param string $name
+     *
+     * @return void
+     */
+    public function onMember(string $name) : void
+    {
+        $this->events->add('member:' . $name);
+    }
+
+    /**
+     * Record the end of a struct.
+     *
+     * @return void
+     */
+    public function onStructEnd() : void
+    {
+        $this->events->add('/struct');
+    }
+
+    /**
+     * Record the start of an array.
+     *
+     * @return void
+     */
+    public function onArrayStart() : void
+    {
+        $this->events->add('array');
+    }
+
+    /**
+     * Record the end of an array.
+     *
+     * @return void
+     */
+    public function onArrayEnd() : void
+    {
+        $this->events->add('/array');
+    }
+
+    /**
+     * Record a scalar.
+     *
+     * @param string $type
+     * @param string $text
+     *
+     * @return void
+     */
+    public function onScalar(string $type, string $text) : void
+    {
+        $this->events->add($type . ':' . $text);
+    }
+
+    /**
+     * Record a custom type, without its XML.
+     *
+     * @param string $type
+     * @param string $xml
+     *
+     * @return void
+     */
+    public function onCustom(string $type, string $xml) : void
+    {
+        $this->events->add('custom:' . $type);
+    }
+}
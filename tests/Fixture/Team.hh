@@ -0,0 +1,48 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+/**
+ * A model with lists and maps declared as other containers than Vector.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class Team
+{
+    /**
+     * The team scores, by member name.
+     *
+     * @var ?ImmMap<string, int>
+     */
+    public ?ImmMap<string, int> $scores = null;
+
+    /**
+     * The team ranks, by season.
+     *
+     * @var array<int>
+     */
+    public array<int> $ranks = [];
+
+    /**
+     * Create a new team.
+     *
+     * @param string $name
+     * @param array<Ivyhjk\Xml\Test\Fixture\Author> $members
+     * @param ImmVector<Ivyhjk\Xml\Test\Fixture\Author> $reviewers
+     *
+     * @return void
+     */
+    public function __construct(
+        public string $name,
+        public array<Author> $members,
+        public ImmVector<Author> $reviewers
+    ) : void
+    {
+
+    }
+}
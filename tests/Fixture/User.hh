@@ -0,0 +1,65 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Fixture;
+
+/**
+ * A plain object for the tests.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Fixture
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+class User
+{
+    /**
+     * A static property, left out of the description.
+     *
+     * @var int
+     */
+    public static int $instances = 0;
+
+    /**
+     * The user identifier.
+     *
+     * @var int
+     */
+    public int $id;
+
+    /**
+     * The user name.
+     *
+     * @var string
+     */
+    public string $name;
+
+    /**
+     * The user nickname, left out of the struct when null.
+     *
+     * @var ?string
+     */
+    public ?string $nickname = null;
+
+    /**
+     * A private property, left out of the description.
+     *
+     * @var string
+     */
+    private string $password = 'secret';
+
+    /**
+     * Create a new user.
+     *
+     * @param int $id
+     * @param string $name
+     *
+     * @return void
+     */
+    public function __construct(int $id, string $name) : void
+    {
+        $this->id = $id;
+        $this->name = $name;
+    }
+}
@@ -0,0 +1,120 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Binary;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Test the binary encoding.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class BinaryTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test that the binary and the XML encodings decode the same values.
+     *
+     * @return void
+     */
+    public function testRoundTrip() : void
+    {
+        $parameters = vec[
+            'foo',
+            -1,
+            \PHP_INT_MAX,
+            \PHP_INT_MIN,
+            1.5,
+            dict['a' => vec[1, 2, 'b'], 'c' => Map{'d' => -0.25}],
+            new Timestamp('20160101T10:20:30'),
+            Base64::fromString("\x00\xff"),
+        ];
+
+        $decoded = Binary::decode(Binary::encode($parameters));
+
+        static::assertEquals(RPC::decode(RPC::encode($parameters)), $decoded);
+        static::assertSame(\PHP_INT_MIN, $decoded->at(3));
+        static::assertSame("\x00\xff", $decoded->at(7));
+    }
+
+    /**
+     * Test that the items of a typed list take the declared type, as they
+     * do into the XML.
+     *
+     * @return void
+     */
+    public function testTypedList() : void
+    {
+        $parameters = vec[
+            new TypedList(ValueType::DOUBLE, vec[1, 2]),
+            new TypedList(ValueType::STRING, vec[1, 2.5]),
+            new TypedList(ValueType::I4, vec['3']),
+        ];
+
+        $decoded = Binary::decode(Binary::encode($parameters));
+
+        invariant($decoded instanceof Vector, 'Vector expected.');
+
+        static::assertEquals(RPC::decode(RPC::encode($parameters)), $decoded);
+
+        $doubles = $decoded->at(0);
+        $strings = $decoded->at(1);
+        $integers = $decoded->at(2);
+
+        invariant($doubles instanceof Vector && $strings instanceof Vector && $integers instanceof Vector, 'Vectors expected.');
+
+        static::assertSame([1.0, 2.0], $doubles->toArray());
+        static::assertSame(['1', '2.5'], $strings->toArray());
+        static::assertSame([3], $integers->toArray());
+    }
+
+    /**
+     * Test the encoded sizes.
+     *
+     * @return void
+     */
+    public function testEncode() : void
+    {
+        static::assertSame("XRB\x01\x01\x02\x01", Binary::encode(-1));
+        static::assertSame("XRB\x01\x02\x01\x03foo\x02\xac\x02", Binary::encode(vec['foo', 150]));
+    }
+
+    /**
+     * Test the Hack arrays output.
+     *
+     * @return void
+     */
+    public function testHackArrays() : void
+    {
+        static::assertSame(
+            dict['a' => vec[1, 'b'], 'c' => dict[]],
+            Binary::decode(Binary::encode(dict['a' => vec[1, 'b'], 'c' => dict[]]), OutputMode::HACK_ARRAY)
+        );
+    }
+
+    /**
+     * Test a truncated document.
+     *
+     * @return void
+     */
+    public function testTruncated() : void
+    {
+        $data = Binary::encode(vec['foo', dict['a' => 1]]);
+
+        $this->expectException(XmlException::class);
+
+        Binary::decode(\substr($data, 0, -1));
+    }
+}
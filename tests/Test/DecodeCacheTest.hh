@@ -0,0 +1,118 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\DecodeCache;
+use Ivyhjk\Xml\Contract\OutputMode;
+
+/**
+ * Test the decoded bodies cache.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class DecodeCacheTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Enable the cache for any body.
+     *
+     * @return void
+     */
+    public function setUp() : void
+    {
+        if ( ! \function_exists('apc_store')) {
+            static::markTestSkipped('APC is not available.');
+        }
+
+        DecodeCache::enable(60, 0);
+        DecodeCache::resetCounters();
+    }
+
+    /**
+     * Disable the cache.
+     *
+     * @return void
+     */
+    public function tearDown() : void
+    {
+        DecodeCache::disable();
+    }
+
+    /**
+     * Test repeated bodies.
+     *
+     * @return void
+     */
+    public function testDecode() : void
+    {
+        $xml = RPC::encode(vec['foo', dict['a' => vec[1, 2]], \microtime()]);
+
+        $first = RPC::decode($xml);
+        $second = RPC::decode($xml);
+
+        static::assertSame(1, DecodeCache::getMisses());
+        static::assertSame(1, DecodeCache::getHits());
+        static::assertInstanceOf(ImmVector::class, $second);
+        static::assertEquals($first, $second);
+        static::assertEquals(ImmMap{'a' => ImmVector{1, 2}}, $second->at(1));
+    }
+
+    /**
+     * Test that the output mode is part of the key.
+     *
+     * @return void
+     */
+    public function testModes() : void
+    {
+        $time = \microtime();
+        $xml = RPC::encode(vec['foo', $time]);
+
+        static::assertEquals(ImmVector{'foo', $time}, RPC::decode($xml));
+        static::assertSame(vec['foo', $time], RPC::decode($xml, OutputMode::HACK_ARRAY));
+        static::assertSame(2, DecodeCache::getMisses());
+    }
+
+    /**
+     * Test that the settings are part of the key.
+     *
+     * @return void
+     */
+    public function testKeyScope() : void
+    {
+        $key = DecodeCache::getKey('<params/>', OutputMode::COLLECTION);
+
+        Config::setBase64SpillSize(1);
+
+        try {
+            static::assertNotSame($key, DecodeCache::getKey('<params/>', OutputMode::COLLECTION));
+        } finally {
+            Config::setBase64SpillSize(Config::DEFAULT_BASE64_SPILL_SIZE);
+        }
+
+        static::assertSame($key, DecodeCache::getKey('<params/>', OutputMode::COLLECTION));
+    }
+
+    /**
+     * Test the size threshold.
+     *
+     * @return void
+     */
+    public function testMinSize() : void
+    {
+        DecodeCache::enable(60, 1048576);
+
+        $xml = RPC::encode(vec['foo', \microtime()]);
+
+        RPC::decode($xml);
+        RPC::decode($xml);
+
+        static::assertSame(0, DecodeCache::getHits() + DecodeCache::getMisses());
+    }
+}
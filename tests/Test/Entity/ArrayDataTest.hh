@@ -0,0 +1,166 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Entity;
+
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Entity\ArrayData;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Test the <array> tag class wrapper correct workflow.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Entity
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class ArrayDataTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the correct workflow for getElement method.
+     *
+     * @return void
+     */
+    public function testGetElement() : void
+    {
+        $document = new DOMDocument();
+
+        $values = Vector{
+            new Value(Vector{'foo'}, $document),
+            new Value(Vector{1337}, $document)
+        };
+
+        $array = new ArrayData($values, $document);
+
+        $document->appendChild($array->getElement());
+
+        $expectedXML = '<?xml version="1.0"?><array><data><value><string>foo</string></value><value><int>1337</int></value></data></array>';
+
+        $xml = \preg_replace('/\n/', '', $document->saveXML());
+
+        static::assertSame($expectedXML, $xml);
+    }
+
+    /**
+     * Test the fromNode error.
+     *
+     * @return void
+     */
+    public function testFromNodeError() : void
+    {
+        $node = new SimpleXMLElement('<invalidTag/>');
+
+        $this->expectException(InvalidNodeException::class);
+        ArrayData::fromNode($node, new DOMDocument());
+    }
+
+    /**
+     * Test the fromNode error when the <data> tag is missing.
+     *
+     * @return void
+     */
+    public function testFromNodeMissingData() : void
+    {
+        $node = new SimpleXMLElement('<array><value><int>1</int></value></array>');
+
+        $this->expectException(InvalidNodeException::class);
+        ArrayData::fromNode($node, new DOMDocument());
+    }
+
+    /**
+     * Test the fromNode method correct workflow.
+     *
+     * @return void
+     */
+    public function testFromNode() : void
+    {
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value>
+                        <int>1</int>
+                    </value>
+                    <value>
+                        <array>
+                            <data>
+                                <value>
+                                    <string>foo</string>
+                                </value>
+                            </data>
+                        </array>
+                    </value>
+                </data>
+            </array>
+        ');
+
+        $arrayEntity = ArrayData::fromNode($node, new DOMDocument());
+
+        static::assertCount(2, $arrayEntity->getValues());
+        static::assertEquals(Vector{1}, $arrayEntity->getValues()->at(0)->getValues());
+        static::assertNull($arrayEntity->getItemType());
+    }
+
+    /**
+     * Test the fromNode method with items of the same scalar type.
+     *
+     * @return void
+     */
+    public function testFromNodeHomogeneous() : void
+    {
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value><int>1</int></value>
+                    <value><int>2</int></value>
+                    <value><int>3</int></value>
+                </data>
+            </array>
+        ');
+
+        $arrayEntity = ArrayData::fromNode($node, new DOMDocument());
+
+        static::assertSame('int', $arrayEntity->getItemType());
+        static::assertCount(3, $arrayEntity->getValues());
+        static::assertEquals(Vector{3}, $arrayEntity->getValues()->at(2)->getValues());
+    }
+
+    /**
+     * Test the fromNode method when the type tags do not match the items
+     * one to one, even if their numbers do.
+     *
+     * @return void
+     */
+    public function testFromNodeUnevenItems() : void
+    {
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value><int>1</int><int>2</int></value>
+                    <value><int>3</int></value>
+                </data>
+            </array>
+        ');
+
+        $arrayEntity = ArrayData::fromNode($node, new DOMDocument());
+
+        static::assertNull($arrayEntity->getItemType());
+        static::assertEquals(Vector{1, 2}, $arrayEntity->getValues()->at(0)->getValues());
+
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value><int>1</int><int>2</int></value>
+                    <value></value>
+                </data>
+            </array>
+        ');
+
+        $this->expectException(InvalidNodeException::class);
+        ArrayData::fromNode($node, new DOMDocument());
+    }
+}
@@ -4,7 +4,13 @@ namespace Ivyhjk\Xml\Test\Entity;
 
 use DOMDocument;
 use SimpleXMLElement;
+use Ivyhjk\Xml\Config;
 use Ivyhjk\Xml\Entity\Value;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
 use Ivyhjk\Xml\Exception\InvalidNodeException;
 
 /**
@@ -109,6 +115,53 @@ class ValueTest extends \PHPUnit_Framework_TestCase
         static::assertEquals($expectedXml, $this->getXml($values));
     }
 
+    /**
+     * Test the getElement method as array value, from a Vector and a PHP list.
+     *
+     * @return void
+     */
+    public function testGetElementArray() : void
+    {
+        $expectedXml = '<?xml version="1.0"?><value><array><data><value><int>1</int></value><value><string>foo</string></value></data></array></value>';
+
+        static::assertEquals($expectedXml, $this->getXml(Vector{Vector{1, 'foo'}}));
+        static::assertEquals($expectedXml, $this->getXml(Vector{[1, 'foo']}));
+    }
+
+    /**
+     * Test the getElement method with lists of same-shape structs
+     * and typed lists.
+     *
+     * @return void
+     */
+    public function testGetElementHomogeneousArray() : void
+    {
+        $expectedXml = '<?xml version="1.0"?><value><array><data><value><struct><member><name>id</name><value><int>1</int></value></member></struct></value><value><struct><member><name>id</name><value><int>2</int></value></member></struct></value></data></array></value>';
+
+        static::assertEquals($expectedXml, $this->getXml(Vector{
+            vec[dict['id' => 1], dict['id' => 2]]
+        }));
+
+        $expectedXml = '<?xml version="1.0"?><value><array><data><value><double>1</double></value><value><double>2.5</double></value></data></array></value>';
+
+        static::assertEquals($expectedXml, $this->getXml(Vector{
+            new TypedList(ValueType::DOUBLE, vec[1.0, 2.5])
+        }));
+    }
+
+    /**
+     * Test that a typed struct list rejects structs with other members.
+     *
+     * @return void
+     */
+    public function testGetElementTypedListShapeError() : void
+    {
+        $this->expectException(XmlException::class);
+        $this->getXml(Vector{
+            new TypedList(ValueType::STRUCT, vec[dict['id' => 1], dict['name' => 'foo']])
+        });
+    }
+
     /**
      * Test the fromNode error.
      *
@@ -318,6 +371,57 @@ class ValueTest extends \PHPUnit_Framework_TestCase
         static::assertEquals($expectedValue, $parsed);
     }
 
+    /**
+     * Test the parseValue method with an array of values.
+     *
+     * @return void
+     */
+    public function testParseValueArray() : void
+    {
+        $node = new SimpleXMLElement('
+            <value>
+                <array>
+                    <data>
+                        <value>
+                            <int>1</int>
+                        </value>
+                        <value>
+                            <struct>
+                                <member>
+                                    <name>foo</name>
+                                    <value>
+                                        <array>
+                                            <data>
+                                                <value>
+                                                    <string>bar</string>
+                                                </value>
+                                            </data>
+                                        </array>
+                                    </value>
+                                </member>
+                            </struct>
+                        </value>
+                    </data>
+                </array>
+            </value>
+        ');
+
+        $entity = Value::fromNode($node, new DOMDocument());
+
+        $expected = Vector{
+            1,
+            Map{
+                'foo' => Vector{'bar'}
+            }
+        };
+
+        static::assertEquals($expected, Value::parseValue($entity));
+        static::assertSame(
+            vec[1, dict['foo' => vec['bar']]],
+            Value::parseValue($entity, OutputMode::HACK_ARRAY)
+        );
+    }
+
     /**
      * Test parseValues method (multiple Value instances).
      *
@@ -387,4 +491,100 @@ class ValueTest extends \PHPUnit_Framework_TestCase
 
         static::assertEquals($expected, $parsed);
     }
+
+    /**
+     * Build a struct nested $depth times.
+     *
+     * @param int $depth The nesting level.
+     *
+     * @return mixed
+     */
+    private function getNested(int $depth) : mixed
+    {
+        $nested = 'leaf';
+
+        for ($i = 1; $i < $depth; $i++) {
+            $nested = Map{'child' => $nested};
+        }
+
+        return $nested;
+    }
+
+    /**
+     * Test that deeply nested values are encoded, decoded and parsed
+     * without exhausting the native stack.
+     *
+     * @return void
+     */
+    public function testDeeplyNestedValues() : void
+    {
+        Config::setMaxDepth(5000);
+
+        try {
+            $nested = $this->getNested(2000);
+
+            $xml = $this->getXml(Vector{$nested});
+
+            $node = new SimpleXMLElement($xml, Config::getParseOptions());
+            $entity = Value::fromNode($node, new DOMDocument());
+
+            static::assertEquals($nested, Value::parseValue($entity));
+        } finally {
+            Config::setMaxDepth(Config::DEFAULT_MAX_DEPTH);
+        }
+    }
+
+    /**
+     * Test that the libxml limits are only lifted for a deep max depth.
+     *
+     * @return void
+     */
+    public function testParseOptions() : void
+    {
+        static::assertSame(0, Config::getParseOptions());
+
+        Config::setMaxDepth(100);
+
+        try {
+            static::assertSame(\LIBXML_PARSE_HUGE, Config::getParseOptions());
+        } finally {
+            Config::setMaxDepth(Config::DEFAULT_MAX_DEPTH);
+        }
+    }
+
+    /**
+     * Test the encode depth limit.
+     *
+     * @return void
+     */
+    public function testGetElementDepthLimit() : void
+    {
+        Config::setMaxDepth(10);
+
+        try {
+            $this->expectException(DepthLimitExceeded::class);
+            $this->getXml(Vector{$this->getNested(11)});
+        } finally {
+            Config::setMaxDepth(Config::DEFAULT_MAX_DEPTH);
+        }
+    }
+
+    /**
+     * Test the decode depth limit.
+     *
+     * @return void
+     */
+    public function testFromNodeDepthLimit() : void
+    {
+        $xml = $this->getXml(Vector{$this->getNested(11)});
+
+        Config::setMaxDepth(10);
+
+        try {
+            $this->expectException(DepthLimitExceeded::class);
+            Value::fromNode(new SimpleXMLElement($xml), new DOMDocument());
+        } finally {
+            Config::setMaxDepth(Config::DEFAULT_MAX_DEPTH);
+        }
+    }
 }
@@ -0,0 +1,208 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Writer;
+use Ivyhjk\Xml\FragmentCache;
+use Ivyhjk\Xml\TypeRegistry;
+use Ivyhjk\Xml\Type\PlaceholderHandler;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Test\Fixture\Country;
+
+/**
+ * Test the encoded fragments cache.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class FragmentCacheTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Enable the cache.
+     *
+     * @return void
+     */
+    public function setUp() : void
+    {
+        Config::setFragmentCacheSize(2);
+        FragmentCache::clear();
+    }
+
+    /**
+     * Restore the default size.
+     *
+     * @return void
+     */
+    public function tearDown() : void
+    {
+        Config::setFragmentCacheSize(Config::DEFAULT_FRAGMENT_CACHE_SIZE);
+        FragmentCache::clear();
+    }
+
+    /**
+     * Test repeated immutable values into a single encode.
+     *
+     * @return void
+     */
+    public function testEncodeRepeatedValues() : void
+    {
+        $address = ImmMap{'city' => 'Santiago', 'zip' => ImmVector{1, 2}};
+
+        $xml = RPC::encode(vec[$address, dict['home' => $address]]);
+
+        // The nested ImmVector is encoded with its parent, never looked up.
+        static::assertSame(1, FragmentCache::getMisses());
+        static::assertSame(1, FragmentCache::getHits());
+        static::assertEquals(
+            Vector{
+                Map{'city' => 'Santiago', 'zip' => Vector{1, 2}},
+                Map{'home' => Map{'city' => 'Santiago', 'zip' => Vector{1, 2}}},
+            },
+            RPC::decode($xml)
+        );
+    }
+
+    /**
+     * Test the least recently used eviction.
+     *
+     * @return void
+     */
+    public function testEviction() : void
+    {
+        RPC::encode(vec[ImmVector{1}, ImmVector{2}, ImmVector{3}]);
+
+        static::assertSame(2, FragmentCache::count());
+        static::assertSame(0, FragmentCache::getHits());
+
+        RPC::encode(vec[ImmVector{1}]);
+
+        static::assertSame(0, FragmentCache::getHits());
+
+        RPC::encode(vec[ImmVector{3}]);
+
+        static::assertSame(1, FragmentCache::getHits());
+    }
+
+    /**
+     * Test tagged objects.
+     *
+     * @return void
+     */
+    public function testCacheableValue() : void
+    {
+        $xml = RPC::encode(vec[new Country('CL', 'Chile'), new Country('CL', 'Chile')]);
+
+        static::assertSame(1, FragmentCache::getHits());
+        static::assertEquals(
+            Vector{Map{'code' => 'CL', 'name' => 'Chile'}, Map{'code' => 'CL', 'name' => 'Chile'}},
+            RPC::decode($xml)
+        );
+    }
+
+    /**
+     * Test the cache into the writer.
+     *
+     * @return void
+     */
+    public function testWriter() : void
+    {
+        $tags = ImmVector{'a', 'b'};
+
+        $writer = (new Writer())->startParams()->value($tags)->value(dict['tags' => $tags])->end();
+
+        static::assertSame(1, FragmentCache::getHits());
+        static::assertEquals(
+            Vector{Vector{'a', 'b'}, Map{'tags' => Vector{'a', 'b'}}},
+            RPC::decode($writer->getOutput())
+        );
+    }
+
+    /**
+     * Test that the keys change with the encoders only, the decoders and
+     * the base64 spill size do not change the encoded bytes.
+     *
+     * @return void
+     */
+    public function testKeyScope() : void
+    {
+        $key = FragmentCache::getKey(ImmVector{1});
+
+        Config::setBase64SpillSize(1);
+
+        try {
+            TypeRegistry::registerDecoder('placeholder', new PlaceholderHandler());
+
+            static::assertSame($key, FragmentCache::getKey(ImmVector{1}));
+
+            TypeRegistry::registerEncoder(Country::class, new PlaceholderHandler());
+
+            static::assertNotSame($key, FragmentCache::getKey(ImmVector{1}));
+        } finally {
+            TypeRegistry::clear();
+            Config::setBase64SpillSize(Config::DEFAULT_BASE64_SPILL_SIZE);
+        }
+
+        static::assertSame($key, FragmentCache::getKey(ImmVector{1}));
+    }
+
+    /**
+     * Test that a fragment reused deeper than it was encoded is checked
+     * against the depth limit.
+     *
+     * @return void
+     */
+    public function testReusedDepthLimit() : void
+    {
+        $list = ImmVector{ImmVector{1}};
+
+        $maxDepth = Config::getMaxDepth();
+
+        Config::setMaxDepth(3);
+
+        try {
+            RPC::encode(vec[$list]);
+
+            $this->expectException(DepthLimitExceeded::class);
+
+            RPC::encode(dict['a' => dict['b' => $list]]);
+        } finally {
+            Config::setMaxDepth($maxDepth);
+        }
+    }
+
+    /**
+     * Test that the writer checks a deep fragment the same way when it is
+     * written and when it is reused.
+     *
+     * @return void
+     */
+    public function testWriterDepthLimit() : void
+    {
+        $value = dict['a' => dict['b' => ImmVector{ImmVector{1}}]];
+
+        $maxDepth = Config::getMaxDepth();
+
+        Config::setMaxDepth(3);
+
+        try {
+            foreach (vec[0, 1] as $hits) {
+                try {
+                    (new Writer())->startParams()->value($value);
+
+                    static::fail('A fragment beyond the depth limit was written.');
+                } catch (DepthLimitExceeded $e) {
+                    static::assertSame($hits, FragmentCache::getHits());
+                }
+            }
+        } finally {
+            Config::setMaxDepth($maxDepth);
+        }
+    }
+}
@@ -0,0 +1,236 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Metadata;
+
+use DateTime;
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Metadata\Hydrator;
+use Ivyhjk\Xml\Metadata\MetadataCache;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Test\Fixture\Post;
+use Ivyhjk\Xml\Test\Fixture\Event;
+use Ivyhjk\Xml\Test\Fixture\Team;
+use Ivyhjk\Xml\Test\Fixture\Author;
+
+/**
+ * Test the build of objects from the decoded structs.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Metadata
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class HydratorTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the constructor parameters description.
+     *
+     * @return void
+     */
+    public function testParameters() : void
+    {
+        $metadata = MetadataCache::get(Author::class);
+
+        static::assertSame(0, $metadata->getParameterPosition('id'));
+        static::assertSame(2, $metadata->getParameterPosition('role'));
+        static::assertNull($metadata->getParameterPosition('email'));
+        static::assertTrue($metadata->getParameters()->at(2)['optional']);
+        static::assertSame('writer', $metadata->getParameters()->at(2)['default']);
+    }
+
+    /**
+     * Test a struct into constructor arguments and properties.
+     *
+     * @return void
+     */
+    public function testHydrate() : void
+    {
+        $node = new SimpleXMLElement(
+            '<value><struct>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '<member><name>email</name><value><string>foo@bar.com</string></value></member>'
+            . '<member><name>id</name><value><int>1</int></value></member>'
+            . '<member><name>unknown</name><value><int>2</int></value></member>'
+            . '</struct></value>'
+        );
+
+        $author = Hydrator::hydrate($node, Author::class, new DOMDocument());
+
+        invariant($author instanceof Author, 'Author expected.');
+
+        static::assertSame(1, $author->id);
+        static::assertSame('foo', $author->name);
+        static::assertSame('writer', $author->role);
+        static::assertSame('foo@bar.com', $author->email);
+    }
+
+    /**
+     * Test a missing required member.
+     *
+     * @return void
+     */
+    public function testHydrateMissingMember() : void
+    {
+        $node = new SimpleXMLElement(
+            '<value><struct><member><name>id</name><value><int>1</int></value></member></struct></value>'
+        );
+
+        $this->expectException(InvalidNodeException::class);
+
+        Hydrator::hydrate($node, Author::class, new DOMDocument());
+    }
+
+    /**
+     * Test a member whose type does not match the declared parameter.
+     *
+     * @return void
+     */
+    public function testHydrateTypeMismatch() : void
+    {
+        $node = new SimpleXMLElement(
+            '<value><struct>'
+            . '<member><name>id</name><value><string>abc</string></value></member>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '</struct></value>'
+        );
+
+        $this->expectException(InvalidNodeException::class);
+
+        Hydrator::hydrate($node, Author::class, new DOMDocument());
+    }
+
+    /**
+     * Test the lists and maps built as their declared containers.
+     *
+     * @return void
+     */
+    public function testHydrateDeclaredContainers() : void
+    {
+        $author = '<value><struct>'
+            . '<member><name>id</name><value><int>1</int></value></member>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '</struct></value>';
+
+        $node = new SimpleXMLElement(
+            '<value><struct>'
+            . '<member><name>name</name><value><string>core</string></value></member>'
+            . '<member><name>members</name><value><array><data>' . $author . '</data></array></value></member>'
+            . '<member><name>reviewers</name><value><array><data>' . $author . '</data></array></value></member>'
+            . '<member><name>scores</name><value><struct>'
+            . '<member><name>foo</name><value><int>3</int></value></member>'
+            . '</struct></value></member>'
+            . '<member><name>ranks</name><value><array><data>'
+            . '<value><int>2</int></value><value><int>1</int></value>'
+            . '</data></array></value></member>'
+            . '</struct></value>'
+        );
+
+        $team = Hydrator::hydrate($node, Team::class, new DOMDocument());
+
+        invariant($team instanceof Team, 'Team expected.');
+
+        static::assertTrue(\is_array($team->members));
+        static::assertInstanceOf(Author::class, $team->members[0]);
+        static::assertInstanceOf(ImmVector::class, $team->reviewers);
+        static::assertSame('foo', $team->reviewers->at(0)->name);
+        static::assertEquals(ImmMap{'foo' => 3}, $team->scores);
+        static::assertSame([2, 1], $team->ranks);
+    }
+
+    /**
+     * Test the decode of nested objects, lists of objects and dates.
+     *
+     * @return void
+     */
+    public function testDecodeInto() : void
+    {
+        $xml = '<?xml version="1.0"?><params><param><value><array><data><value><struct>'
+            . '<member><name>title</name><value><string>Hello</string></value></member>'
+            . '<member><name>published</name><value><dateTime.iso8601>20160102T03:04:05</dateTime.iso8601></value></member>'
+            . '<member><name>author</name><value><struct>'
+            . '<member><name>id</name><value><int>1</int></value></member>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '</struct></value></member>'
+            . '<member><name>reviewers</name><value><array><data><value><struct>'
+            . '<member><name>id</name><value><int>2</int></value></member>'
+            . '<member><name>name</name><value><string>bar</string></value></member>'
+            . '<member><name>role</name><value><string>editor</string></value></member>'
+            . '</struct></value></data></array></value></member>'
+            . '</struct></value></data></array></value></param></params>';
+
+        $posts = RPC::decodeInto($xml, Post::class);
+
+        invariant($posts instanceof Vector, 'Vector expected.');
+
+        static::assertSame(1, $posts->count());
+
+        $post = $posts->at(0);
+
+        invariant($post instanceof Post, 'Post expected.');
+
+        static::assertSame('Hello', $post->title);
+        static::assertSame('foo', $post->author->name);
+        static::assertSame(1, $post->reviewers->count());
+        static::assertSame('editor', $post->reviewers->at(0)->role);
+        static::assertSame('2016-01-02 03:04:05', $post->published?->format('Y-m-d H:i:s'));
+    }
+
+    /**
+     * Test a DateTime target, dates are decoded immutable.
+     *
+     * @return void
+     */
+    public function testHydrateDateTime() : void
+    {
+        $node = new SimpleXMLElement(
+            '<value><struct>'
+            . '<member><name>name</name><value><string>launch</string></value></member>'
+            . '<member><name>date</name><value><dateTime.iso8601>20160102T03:04:05</dateTime.iso8601></value></member>'
+            . '</struct></value>'
+        );
+
+        $event = Hydrator::hydrate($node, Event::class, new DOMDocument());
+
+        invariant($event instanceof Event, 'Event expected.');
+
+        static::assertInstanceOf(DateTime::class, $event->date);
+        static::assertSame('2016-01-02 03:04:05', $event->date->format('Y-m-d H:i:s'));
+    }
+
+    /**
+     * Test that the depth limit holds through the built objects.
+     *
+     * @return void
+     */
+    public function testHydrateDepthLimit() : void
+    {
+        $node = new SimpleXMLElement(
+            '<value><struct>'
+            . '<member><name>id</name><value><int>1</int></value></member>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '<member><name>email</name><value><array><data><value><array><data>'
+            . '<value><string>a</string></value>'
+            . '</data></array></value></data></array></value></member>'
+            . '</struct></value>'
+        );
+
+        $maxDepth = Config::getMaxDepth();
+
+        Config::setMaxDepth(3);
+
+        try {
+            $this->expectException(DepthLimitExceeded::class);
+
+            Hydrator::hydrate($node, Author::class, new DOMDocument());
+        } finally {
+            Config::setMaxDepth($maxDepth);
+        }
+    }
+}
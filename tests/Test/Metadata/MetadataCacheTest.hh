@@ -0,0 +1,101 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Metadata;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Metadata\MetadataCache;
+use Ivyhjk\Xml\Test\Fixture\User;
+use Ivyhjk\Xml\Test\Fixture\Money;
+use Ivyhjk\Xml\Test\Fixture\Price;
+
+/**
+ * Test the class descriptions cache.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Metadata
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class MetadataCacheTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the description of a class, only the public instance properties.
+     *
+     * @return void
+     */
+    public function testGet() : void
+    {
+        $metadata = MetadataCache::get(User::class);
+
+        static::assertSame($metadata, MetadataCache::get(User::class));
+        static::assertEquals(Vector{'id', 'name', 'nickname'}, $metadata->getNames());
+        static::assertSame('int', $metadata->getType('id'));
+    }
+
+    /**
+     * Test the encode of a plain object as a struct, null properties
+     * are left out.
+     *
+     * @return void
+     */
+    public function testEncodeObject() : void
+    {
+        $user = new User(1, 'foo');
+
+        $expected = '<struct>'
+            . '<member><name>id</name><value><int>1</int></value></member>'
+            . '<member><name>name</name><value><string>foo</string></value></member>'
+            . '</struct>';
+
+        static::assertContains($expected, \preg_replace('/\n/', '', RPC::encode(vec[$user])));
+    }
+
+    /**
+     * Test that the APC keys are scoped by the cache format and the class.
+     *
+     * @return void
+     */
+    public function testApcKey() : void
+    {
+        $key = MetadataCache::getApcKey(User::class);
+
+        static::assertStringStartsWith(MetadataCache::APC_PREFIX . Config::CACHE_FORMAT . '.' . User::class . '.', $key);
+        static::assertSame($key, MetadataCache::getApcKey(User::class));
+        static::assertNotSame($key, MetadataCache::getApcKey(MetadataCacheTest::class));
+    }
+
+    /**
+     * Test that the APC key follows the parent classes, and that it is
+     * computed once by request.
+     *
+     * @return void
+     */
+    public function testApcKeyParents() : void
+    {
+        $file = (string) (new \ReflectionClass(Money::class))->getFileName();
+        $mtime = (int) \filemtime($file);
+
+        MetadataCache::clear();
+
+        $key = MetadataCache::getApcKey(Price::class);
+
+        try {
+            \touch($file, $mtime + 10);
+            \clearstatcache();
+
+            static::assertSame($key, MetadataCache::getApcKey(Price::class));
+
+            MetadataCache::clear();
+
+            static::assertNotSame($key, MetadataCache::getApcKey(Price::class));
+        } finally {
+            \touch($file, $mtime);
+            \clearstatcache();
+            MetadataCache::clear();
+        }
+    }
+}
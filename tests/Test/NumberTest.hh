@@ -0,0 +1,125 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\Number;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+
+/**
+ * Test the number formatting and parsing.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class NumberTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the formatDouble method output.
+     *
+     * @return void
+     */
+    public function testFormatDouble() : void
+    {
+        static::assertSame('13.37', Number::formatDouble(13.37));
+        static::assertSame('0.1', Number::formatDouble(0.1));
+        static::assertSame('-2.5', Number::formatDouble(-2.5));
+        static::assertSame('3', Number::formatDouble(3.0));
+        static::assertSame('0.0001', Number::formatDouble(0.0001));
+        static::assertSame('1.0E-5', Number::formatDouble(0.00001));
+        static::assertSame('1.0E+20', Number::formatDouble(1.0E+20));
+        static::assertSame('0.30000000000000004', Number::formatDouble(0.1 + 0.2));
+        static::assertSame('0', Number::formatDouble(0.0));
+    }
+
+    /**
+     * Test that every formatted double parses back to the same double.
+     *
+     * @return void
+     */
+    public function testFormatDoubleRoundTrip() : void
+    {
+        $values = [
+            \M_PI,
+            1 / 3,
+            2.2250738585072014E-308,
+            1.7976931348623157E+308,
+            123456789012345678.0,
+            -9.87654321E-12
+        ];
+
+        foreach ($values as $value) {
+            static::assertSame($value, Number::parseDouble(Number::formatDouble($value)));
+        }
+    }
+
+    /**
+     * Test the formatDouble error with values XML RPC can not hold.
+     *
+     * @return void
+     */
+    public function testFormatDoubleError() : void
+    {
+        $this->expectException(InvalidValueException::class);
+        Number::formatDouble(\NAN);
+    }
+
+    /**
+     * Test the parseDouble error with a malformed double.
+     *
+     * @return void
+     */
+    public function testParseDoubleError() : void
+    {
+        $this->expectException(InvalidValueException::class);
+        Number::parseDouble('13.37abc');
+    }
+
+    /**
+     * Test the parseInt method correct workflow.
+     *
+     * @return void
+     */
+    public function testParseInt() : void
+    {
+        static::assertSame(1337, Number::parseInt(' 1337 '));
+        static::assertSame(-42, Number::parseInt('-00042'));
+        static::assertSame(7, Number::parseInt('+7'));
+        static::assertSame(\PHP_INT_MAX, Number::parseInt('9223372036854775807'));
+        static::assertSame(\PHP_INT_MIN, Number::parseInt('-9223372036854775808'));
+        static::assertSame(-2147483648, Number::parseInt('-2147483648', 32));
+    }
+
+    /**
+     * Test the parseInt method with malformed and out of range integers.
+     *
+     * @return void
+     */
+    public function testParseIntErrors() : void
+    {
+        $invalid = [
+            ['', 64],
+            ['-', 64],
+            ['12a', 64],
+            ['1.5', 64],
+            ['9223372036854775808', 64],
+            ['-9223372036854775809', 64],
+            ['2147483648', 32]
+        ];
+
+        foreach ($invalid as $case) {
+            list($text, $bits) = $case;
+
+            try {
+                Number::parseInt($text, $bits);
+                static::fail(\sprintf('"%s" should be rejected.', $text));
+            } catch (InvalidValueException $e) {
+                static::assertContains($text, $e->getMessage());
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\ParamIndex;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Test the params index.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class ParamIndexTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the decode of a single param.
+     *
+     * @return void
+     */
+    public function testDecodeParam() : void
+    {
+        $xml = RPC::encode(vec['foo', vec[1, 2], dict['a' => 1, 'b' => dict['c' => 'd']]]);
+
+        $index = ParamIndex::build($xml);
+
+        static::assertSame(3, $index->count());
+        static::assertSame('foo', $index->decodeParam($xml, 0));
+        static::assertEquals(Vector{1, 2}, $index->decodeParam($xml, 1));
+        static::assertEquals(Map{'a' => 1, 'b' => Map{'c' => 'd'}}, $index->decodeParam($xml, 2));
+        static::assertEquals(Vector{}, $index->getMemberNames(2));
+    }
+
+    /**
+     * Test the decode of a single member of a struct param.
+     *
+     * @return void
+     */
+    public function testDecodeMember() : void
+    {
+        $xml = '<?xml version="1.0"?><methodResponse><params><param><value><struct>'
+            . '<member><name>a</name><value><int>1</int></value></member>'
+            . '<member><name>b</name><value><struct>'
+            . '<member><name>c</name><value><string>d</string></value></member>'
+            . '</struct></value></member>'
+            . '</struct></value></param></params></methodResponse>';
+
+        $index = ParamIndex::build($xml, true);
+
+        static::assertEquals(Vector{'a', 'b'}, $index->getMemberNames(0));
+        static::assertSame(1, $index->decodeMember($xml, 0, 'a'));
+        static::assertEquals(Map{'c' => 'd'}, $index->decodeMember($xml, 0, 'b'));
+
+        $this->expectException(InvalidNodeException::class);
+        $index->decodeMember($xml, 0, 'c');
+    }
+
+    /**
+     * Test that a cached index is checked against its body.
+     *
+     * @return void
+     */
+    public function testCachedIndex() : void
+    {
+        $xml = RPC::encode(vec[1, 2]);
+
+        $index = \unserialize(\serialize(ParamIndex::build($xml)));
+
+        invariant($index instanceof ParamIndex, 'ParamIndex expected.');
+
+        static::assertTrue($index->matches($xml));
+        static::assertFalse($index->matches(RPC::encode(vec[1, 3])));
+        static::assertSame(2, $index->decodeParam($xml, 1));
+    }
+
+    /**
+     * Test a body encoded in iso-8859-1, the slices keep its encoding.
+     *
+     * @return void
+     */
+    public function testLatin1Body() : void
+    {
+        $xml = RPC::encode(vec['año', dict['señal' => 'ñandú']], 'iso-8859-1');
+
+        $index = ParamIndex::build($xml, true);
+
+        static::assertSame('año', $index->decodeParam($xml, 0));
+        static::assertSame('ñandú', $index->decodeMember($xml, 1, 'señal'));
+    }
+
+    /**
+     * Test a body of the same length than the indexed one.
+     *
+     * @return void
+     */
+    public function testMismatchedBody() : void
+    {
+        $index = ParamIndex::build(RPC::encode(vec[1, 2]));
+
+        $this->expectException(XmlException::class);
+
+        $index->decodeParam(RPC::encode(vec[1, 3]), 1);
+    }
+
+    /**
+     * Test that the verified body is neither serialized nor trusted for
+     * another body.
+     *
+     * @return void
+     */
+    public function testVerifiedBody() : void
+    {
+        $xml = RPC::encode(vec[1, 2]);
+        $index = ParamIndex::build($xml);
+
+        static::assertSame(1, $index->decodeParam($xml, 0));
+        static::assertNotContains('<params>', \serialize($index));
+
+        $this->expectException(XmlException::class);
+
+        $index->decodeParam(RPC::encode(vec[1, 3]), 1);
+    }
+
+    /**
+     * Test the build with an unbalanced document.
+     *
+     * @return void
+     */
+    public function testBuildError() : void
+    {
+        $this->expectException(XmlException::class);
+
+        ParamIndex::build('<params><param></params>');
+    }
+}
@@ -1,17 +1,19 @@
 <?hh // strict
 
-namespace Ivyhjk\Test\Xml;
+namespace Ivyhjk\Xml\Test;
 
 use SimpleXMLElement;
 use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\Contract\OutputMode;
 use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
 
 /**
  * Test xml test workflow.
  *
  * @since v1.0.0
  * @version v1.0.0
- * @package Ivyhjk\Test\Xml
+ * @package Ivyhjk\Xml\Test
  * @author Elvis Munoz <elvis.munoz.f@gmail.com>
  * @copyright Copyright (c) 2016, Elvis Munoz
  * @license https://opensource.org/licenses/MIT MIT License
@@ -298,4 +300,178 @@ class RPCRequestTest extends \PHPUnit_Framework_TestCase
 
         static::assertEquals($expected, $encoded);
     }
+
+    /**
+     * Test the decode method with Hack arrays as output.
+     *
+     * @return void
+     */
+    public function testDecodeHackArrays() : void
+    {
+        $xml = '
+        <methodCall>
+            <methodName>MyMethod</methodName>
+            <params>
+                <param>
+                    <value>
+                        <string>aa</string>
+                    </value>
+                </param>
+                <param>
+                    <value>
+                        <struct>
+                            <member>
+                                <name>foo</name>
+                                <value>
+                                    <string>bar</string>
+                                </value>
+                            </member>
+                        </struct>
+                    </value>
+                </param>
+            </params>
+        </methodCall>
+        ';
+
+        $decoded = RPCRequest::decode($xml, OutputMode::HACK_ARRAY);
+
+        static::assertSame('MyMethod', $decoded->at('method'));
+        static::assertSame(vec['aa', dict['foo' => 'bar']], $decoded->at('parameters'));
+    }
+
+    /**
+     * Test the method name peek from a string and from a stream.
+     *
+     * @return void
+     */
+    public function testPeekMethod() : void
+    {
+        $xml = '<?xml version="1.0"?><methodCall><methodName>foo.bar&amp;baz</methodName>'
+            . '<params><param><value><string>' . \str_repeat('a', 20000) . '</string></value></param></params>'
+            . '</methodCall>';
+
+        static::assertSame('foo.bar&baz', RPCRequest::peekMethod($xml));
+
+        $stream = \fopen('php://memory', 'r+');
+        \fwrite($stream, $xml);
+        \rewind($stream);
+
+        static::assertSame('foo.bar&baz', RPCRequest::peekMethod($stream));
+        static::assertLessThan(\strlen($xml), \ftell($stream));
+
+        \fclose($stream);
+    }
+
+    /**
+     * Test the peek of a stream whose <methodName> tag is split between
+     * two read chunks.
+     *
+     * @return void
+     */
+    public function testPeekMethodSplitTag() : void
+    {
+        $head = '<?xml version="1.0"?><methodCall><!--';
+        $padding = \str_repeat('x', RPCRequest::PEEK_CHUNK_SIZE - \strlen($head) - 5);
+
+        $stream = \fopen('php://memory', 'r+');
+        \fwrite($stream, $head . $padding . '--><methodName>foo.bar</methodName><params></params></methodCall>');
+        \rewind($stream);
+
+        static::assertSame('foo.bar', RPCRequest::peekMethod($stream));
+
+        \fclose($stream);
+    }
+
+    /**
+     * Test the peek of a request without method name.
+     *
+     * @return void
+     */
+    public function testPeekMethodMissing() : void
+    {
+        $this->expectException(XmlException::class);
+
+        RPCRequest::peekMethod('<methodCall><params></params></methodCall>');
+    }
+
+    /**
+     * Test the method name rewrite, the params are forwarded byte by byte.
+     *
+     * @return void
+     */
+    public function testProxy() : void
+    {
+        $params = '<params><param><value><double>1.50</double></value></param></params>';
+        $xml = '<?xml version="1.0"?><methodCall><methodName>foo.bar</methodName>' . $params . '</methodCall>';
+
+        $rename = (string $name) ==> 'v2.' . $name;
+
+        static::assertSame(
+            '<?xml version="1.0"?><methodCall><methodName>v2.foo.bar</methodName>' . $params . '</methodCall>',
+            RPCRequest::proxy($xml, $rename, null, true)
+        );
+
+        $input = \fopen('php://memory', 'r+');
+        $output = \fopen('php://memory', 'r+');
+        \fwrite($input, \str_replace('1.50', \str_repeat('1', 20000), $xml));
+        \rewind($input);
+
+        static::assertSame('', RPCRequest::proxy($input, $rename, $output));
+
+        \rewind($output);
+
+        static::assertSame(
+            \str_replace(['foo.bar', '1.50'], ['v2.foo.bar', \str_repeat('1', 20000)], $xml),
+            \stream_get_contents($output)
+        );
+
+        \fclose($input);
+        \fclose($output);
+    }
+
+    /**
+     * Test the validation of a forwarded request.
+     *
+     * @return void
+     */
+    public function testProxyInvalidParams() : void
+    {
+        $this->expectException(InvalidNodeException::class);
+
+        RPCRequest::proxy(
+            '<methodCall><methodName>foo</methodName><params><param><int>1</int></param></params></methodCall>',
+            (string $name) ==> $name,
+            null,
+            true
+        );
+    }
+
+    /**
+     * Test a batch of requests with an invalid one into it.
+     *
+     * @return void
+     */
+    public function testDecodeMany() : void
+    {
+        $result = RPCRequest::decodeMany(Vector{
+            '<methodCall><params></params></methodCall>',
+            RPCRequest::encode('foo', vec['bar']),
+        });
+
+        static::assertInstanceOf(XmlException::class, $result->getError(0));
+        static::assertNull($result->getValues()->at(0));
+        static::assertEquals(Map{'method' => 'foo', 'parameters' => Vector{'bar'}}, $result->getValues()->at(1));
+    }
+
+    /**
+     * Test that the requests are not decoded as columns.
+     *
+     * @return void
+     */
+    public function testDecodeColumnar() : void
+    {
+        $this->expectException(XmlException::class);
+
+        RPCRequest::decode(RPCRequest::encode('foo', vec[vec[dict['a' => 1]]]), OutputMode::COLUMNAR);
+    }
 }
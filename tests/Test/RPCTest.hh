@@ -1,16 +1,21 @@
 <?hh // strict
 
-namespace Ivyhk\Xml\Test;
+namespace Ivyhjk\Xml\Test;
 
 use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Type\Columnar;
+use Ivyhjk\Xml\Contract\OutputMode;
 use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
 
 /**
  * Test XML RPC workflow.
  *
  * @since v1.0.0
  * @version v1.0.0
- * @package Ivyhk\Xml\Test
+ * @package Ivyhjk\Xml\Test
  * @author Elvis Munoz <elvis.munoz.f@gmail.com>
  * @copyright Copyright (c) 2016, Elvis Munoz
  * @license Private license
@@ -334,4 +339,228 @@ class RPCTest extends \PHPUnit_Framework_TestCase
 
         static::assertEquals($expected, $decoded);
     }
+
+    /**
+     * Test the decode method with Hack arrays as output.
+     *
+     * @return void
+     */
+    public function testDecodeHackArrays() : void
+    {
+        // minify the xml.
+        $xml = \preg_replace(['/>\s+</', '/\n/', '/\s+</'], ['><', '', '<'],'
+            <params>
+                <param>
+                    <value>
+                        <struct>
+                            <member>
+                                <name>foo</name>
+                                <value>
+                                    <string>bar</string>
+                                </value>
+                            </member>
+                            <member>
+                                <name>baz</name>
+                                <value>
+                                    <struct>
+                                        <member>
+                                            <name>zzz</name>
+                                            <value>
+                                                <int>1337</int>
+                                            </value>
+                                        </member>
+                                    </struct>
+                                </value>
+                            </member>
+                        </struct>
+                    </value>
+                </param>
+                <param>
+                    <value>
+                        <string>foo</string>
+                    </value>
+                </param>
+            </params>'
+        );
+
+        $expected = vec[
+            dict[
+                'foo' => 'bar',
+                'baz' => dict[
+                    'zzz' => 1337
+                ]
+            ],
+            'foo'
+        ];
+
+        static::assertSame($expected, RPC::decode($xml, OutputMode::HACK_ARRAY));
+    }
+
+    /**
+     * Test the encode method with Hack arrays, a dict is a struct
+     * and a nested vec is an array.
+     *
+     * @return void
+     */
+    public function testEncodeHackArrays() : void
+    {
+        $expected = \preg_replace(['/>\s+</', '/\n/', '/\s+</'], ['><', '', '<'],'
+            <?xml version="1.0" encoding="utf-8"?>
+            <params>
+                <param>
+                    <value>
+                        <struct>
+                            <member>
+                                <name>0</name>
+                                <value>
+                                    <array>
+                                        <data>
+                                            <value>
+                                                <int>1</int>
+                                            </value>
+                                            <value>
+                                                <string>foo</string>
+                                            </value>
+                                        </data>
+                                    </array>
+                                </value>
+                            </member>
+                        </struct>
+                    </value>
+                </param>
+            </params>');
+
+        $encoded = \preg_replace('/\n/', '', RPC::encode(dict[0 => vec[1, 'foo']]));
+
+        static::assertSame($expected, $encoded);
+    }
+
+    /**
+     * Test the decode method with columnar output.
+     *
+     * @return void
+     */
+    public function testDecodeColumnar() : void
+    {
+        // minify the xml.
+        $xml = \preg_replace(['/>\s+</', '/\n/', '/\s+</'], ['><', '', '<'],'
+            <methodResponse>
+                <params>
+                    <param>
+                        <value>
+                            <array>
+                                <data>
+                                    <value>
+                                        <struct>
+                                            <member>
+                                                <name>id</name>
+                                                <value><int>1</int></value>
+                                            </member>
+                                        </struct>
+                                    </value>
+                                    <value>
+                                        <struct>
+                                            <member>
+                                                <name>id</name>
+                                                <value><int>2</int></value>
+                                            </member>
+                                        </struct>
+                                    </value>
+                                </data>
+                            </array>
+                        </value>
+                    </param>
+                </params>
+            </methodResponse>'
+        );
+
+        $decoded = RPC::decode($xml, OutputMode::COLUMNAR);
+
+        static::assertInstanceOf(Columnar::class, $decoded);
+        invariant($decoded instanceof Columnar, 'Columnar expected.');
+
+        static::assertSame(2, $decoded->getRowCount());
+        static::assertEquals(Vector{1, 2}, $decoded->getColumn('id'));
+    }
+
+    /**
+     * Test that the cells of a columnar decode keep the nesting depth.
+     *
+     * @return void
+     */
+    public function testDecodeColumnarDepthLimit() : void
+    {
+        $xml = RPC::encode(vec[vec[dict['a' => vec[1]], dict['a' => vec[2]]]]);
+
+        $maxDepth = Config::getMaxDepth();
+
+        Config::setMaxDepth(3);
+
+        try {
+            $this->expectException(DepthLimitExceeded::class);
+
+            RPC::decode($xml, OutputMode::COLUMNAR);
+        } finally {
+            Config::setMaxDepth($maxDepth);
+        }
+    }
+
+    /**
+     * Test that equal values give the same canonical encode and hash.
+     *
+     * @return void
+     */
+    public function testEncodeCanonical() : void
+    {
+        $first = dict['b' => 1, 'a' => Map{'y' => -0.0, 'x' => 0.1 + 0.2}];
+        $second = Map{'a' => dict['x' => 0.30000000000000004, 'y' => 0.0], 'b' => 1};
+
+        $expected = '<?xml version="1.0" encoding="utf-8"?><params><param><value><struct>'
+            . '<member><name>a</name><value><struct>'
+            . '<member><name>x</name><value><double>0.30000000000000004</double></value></member>'
+            . '<member><name>y</name><value><double>0</double></value></member>'
+            . '</struct></value></member>'
+            . '<member><name>b</name><value><int>1</int></value></member>'
+            . '</struct></value></param></params>';
+
+        static::assertSame($expected, RPC::encodeCanonical($first));
+        static::assertSame($expected, RPC::encodeCanonical($second));
+        static::assertSame(\hash('sha256', $expected), RPC::hash($first));
+        static::assertSame(RPC::hash($first, 'md5'), RPC::hash($second, 'md5'));
+        static::assertNotSame(RPC::hash($first), RPC::hash(dict['b' => 2]));
+    }
+
+    /**
+     * Test that member names equal as text are rejected by the canonical
+     * encode.
+     *
+     * @return void
+     */
+    public function testEncodeCanonicalDuplicateMembers() : void
+    {
+        $this->expectException(InvalidValueException::class);
+
+        RPC::encodeCanonical(Map{1 => 'a', '1' => 'b'});
+    }
+
+    /**
+     * Test a batch with a malformed document into it.
+     *
+     * @return void
+     */
+    public function testDecodeMany() : void
+    {
+        $result = RPC::decodeMany(vec[
+            RPC::encode(vec['foo', 1]),
+            '<params><param>',
+            RPC::encode(dict['a' => 1.5]),
+        ]);
+
+        static::assertSame(3, $result->count());
+        static::assertTrue($result->hasErrors());
+        static::assertEquals(Vector{Vector{'foo', 1}, null, Map{'a' => 1.5}}, $result->getValues());
+        static::assertNull($result->getError(0));
+        static::assertInstanceOf(XmlException::class, $result->getError(1));
+        static::assertSame(Vector{1}, $result->getErrors()->keys());
+    }
 }
@@ -0,0 +1,68 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\TypeRegistry;
+use Ivyhjk\Xml\Type\Placeholder;
+use Ivyhjk\Xml\Exception\InvalidValueException;
+
+/**
+ * Test the prepared requests.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class RequestTemplateTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test that a rendered template decodes as the encoded request.
+     *
+     * @return void
+     */
+    public function testRender() : void
+    {
+        $template = RPCRequest::prepare('user.update', vec[
+            new Placeholder('id'),
+            dict['name' => new Placeholder('name'), 'tags' => vec['a', new Placeholder('tag')]],
+        ]);
+
+        static::assertEquals(Vector{'id', 'name', 'tag'}, $template->getPlaceholders());
+
+        // The placeholders are not left into the process wide registry.
+        static::assertNull(TypeRegistry::getEncoder(new Placeholder('id')));
+
+        $values = dict['id' => 7, 'name' => 'Ñandú & <co>', 'tag' => 1.5];
+
+        $rendered = $template->render($values);
+        $expected = RPCRequest::encode('user.update', vec[7, dict['name' => 'Ñandú & <co>', 'tags' => vec['a', 1.5]]]);
+
+        static::assertEquals(RPCRequest::decode($expected), RPCRequest::decode($rendered));
+
+        $rendered = $template->render(dict['id' => 8, 'name' => 'foo', 'tag' => 'b']);
+
+        static::assertEquals(
+            Vector{8, Map{'name' => 'foo', 'tags' => Vector{'a', 'b'}}},
+            RPCRequest::decode($rendered)->at('parameters')
+        );
+    }
+
+    /**
+     * Test a render without every value.
+     *
+     * @return void
+     */
+    public function testMissingValue() : void
+    {
+        $template = RPCRequest::prepare('foo', vec[new Placeholder('a'), new Placeholder('b')]);
+
+        $this->expectException(InvalidValueException::class);
+
+        $template->render(dict['a' => 1]);
+    }
+}
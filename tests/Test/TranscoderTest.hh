@@ -0,0 +1,204 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\Transcoder;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Test the JSON transcoder.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class TranscoderTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test XML into JSON.
+     *
+     * @return void
+     */
+    public function testToJson() : void
+    {
+        $xml = RPC::encode(vec['a/é', 1, 2.0, dict['b' => vec[1.5, 'c'], 'd' => dict[]]]);
+
+        static::assertSame(
+            '["a/é",1,2.0,{"b":[1.5,"c"],"d":{}}]',
+            Transcoder::toJson($xml)
+        );
+    }
+
+    /**
+     * Test a request into JSON.
+     *
+     * @return void
+     */
+    public function testRequestToJson() : void
+    {
+        $xml = RPCRequest::encode('foo.bar', vec['baz']);
+
+        static::assertSame('{"methodName":"foo.bar","params":["baz"]}', Transcoder::toJson($xml));
+    }
+
+    /**
+     * Test JSON into XML, written into a stream.
+     *
+     * @return void
+     */
+    public function testToXml() : void
+    {
+        $stream = \fopen('php://memory', 'r+');
+
+        $json = ' [ "aé\"" , -3, 1e2, {"b": [], "c": {"d": 0.5}} ] ';
+
+        static::assertSame('', Transcoder::toXml($json, $stream));
+
+        \rewind($stream);
+
+        static::assertEquals(
+            Vector{"a\u{e9}\"", -3, 100.0, Map{'b' => Vector{}, 'c' => Map{'d' => 0.5}}},
+            RPC::decode((string) \stream_get_contents($stream))
+        );
+
+        \fclose($stream);
+    }
+
+    /**
+     * Test the JSON requests into a <methodCall>, a top level object is
+     * otherwise a single struct param.
+     *
+     * @return void
+     */
+    public function testRequestToXml() : void
+    {
+        $json = '{"methodName":"foo.bar","params":["baz",{"a":1}]}';
+        $xml = Transcoder::toXml($json);
+
+        static::assertEquals(RPCRequest::decode(RPCRequest::encode('foo.bar', vec['baz', dict['a' => 1]])), RPCRequest::decode($xml));
+        static::assertSame($json, Transcoder::toJson($xml));
+
+        static::assertEquals(Vector{Map{'a' => 1}}, RPC::decode(Transcoder::toXml('{"a":1}')));
+        static::assertEquals(Vector{Map{}}, RPC::decode(Transcoder::toXml('{}')));
+    }
+
+    /**
+     * Test that the JSON faults are rejected.
+     *
+     * @return void
+     */
+    public function testFaultToXml() : void
+    {
+        $this->expectException(XmlException::class);
+
+        Transcoder::toXml('{"fault":{"faultCode":1,"faultString":"a"}}');
+    }
+
+    /**
+     * Test that the nesting limit covers the scalars, like RPC::encode.
+     *
+     * @return void
+     */
+    public function testDepthLimit() : void
+    {
+        $maxDepth = Config::getMaxDepth();
+
+        try {
+            Config::setMaxDepth(2);
+
+            static::assertEquals(Vector{Map{'a' => Map{}}}, RPC::decode(Transcoder::toXml('[{"a":{}}]')));
+
+            $this->expectException(DepthLimitExceeded::class);
+
+            Transcoder::toXml('[{"a":{"b":1}}]');
+        } finally {
+            Config::setMaxDepth($maxDepth);
+        }
+    }
+
+    /**
+     * Test both directions reading the input from streams, with tokens
+     * across the read chunks.
+     *
+     * @return void
+     */
+    public function testStreamInput() : void
+    {
+        $json = '[' . \str_repeat('12345,', 2000) . '"' . \str_repeat('a\\"é', 5000) . '",{"b":-2.5}]';
+
+        $input = \fopen('php://memory', 'r+');
+        \fwrite($input, $json);
+        \rewind($input);
+
+        $xml = Transcoder::toXml($input);
+
+        \fclose($input);
+
+        static::assertSame($xml, Transcoder::toXml($json));
+
+        $input = \fopen('php://memory', 'r+');
+        \fwrite($input, $xml);
+        \rewind($input);
+
+        static::assertSame(Transcoder::toJson($xml), Transcoder::toJson($input));
+
+        \fclose($input);
+    }
+
+    /**
+     * Test that both directions give back the same JSON.
+     *
+     * @return void
+     */
+    public function testRoundTrip() : void
+    {
+        $json = '[{"a":[1,-2.5,"x"],"b":{"c":"d"}},"e"]';
+
+        static::assertSame($json, Transcoder::toJson(Transcoder::toXml($json)));
+    }
+
+    /**
+     * Test the JSON values without XML RPC type.
+     *
+     * @return void
+     */
+    public function testUnsupportedJson() : void
+    {
+        $this->expectException(UnsupportedValueType::class);
+
+        Transcoder::toXml('{"a": null}');
+    }
+
+    /**
+     * Test a malformed JSON.
+     *
+     * @return void
+     */
+    public function testMalformedJson() : void
+    {
+        $this->expectException(XmlException::class);
+
+        Transcoder::toXml('{"a": [1, 2}');
+    }
+
+    /**
+     * Test an input that is neither a string nor a stream.
+     *
+     * @return void
+     */
+    public function testInvalidInput() : void
+    {
+        $this->expectException(XmlException::class);
+
+        Transcoder::toJson(1);
+    }
+}
@@ -0,0 +1,124 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Type;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Binary;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\UnsupportedValueType;
+
+/**
+ * Test the <base64> values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class Base64Test extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the encode method, from a string and from a stream.
+     *
+     * @return void
+     */
+    public function testEncode() : void
+    {
+        $data = \str_repeat("\x00\x01binary\xff", 10000);
+
+        $stream = \fopen('php://memory', 'w+b');
+        \fwrite($stream, $data);
+        \rewind($stream);
+
+        static::assertSame(\base64_encode($data), \implode('', \iterator_to_array(Base64::fromString($data)->encode(), false)));
+        static::assertSame(\base64_encode($data), \implode('', \iterator_to_array(Base64::fromStream($stream)->encode(), false)));
+    }
+
+    /**
+     * Test the decode method with a small value and line breaks.
+     *
+     * @return void
+     */
+    public function testDecodeString() : void
+    {
+        static::assertSame('foo bar', Base64::decode("Zm9v\nIGJh\r\ncg=="));
+    }
+
+    /**
+     * Test the decode method when the value is spilled into a stream.
+     *
+     * @return void
+     */
+    public function testDecodeSpill() : void
+    {
+        $data = \str_repeat("\x00\x01binary\xff", 10000);
+
+        Config::setBase64SpillSize(1024);
+
+        try {
+            $decoded = Base64::decode(\chunk_split(\base64_encode($data), 76, "\n"));
+        } finally {
+            Config::setBase64SpillSize(Config::DEFAULT_BASE64_SPILL_SIZE);
+        }
+
+        static::assertTrue(is_resource($decoded));
+        invariant(is_resource($decoded), 'A stream was expected.');
+
+        static::assertSame($data, \stream_get_contents($decoded));
+    }
+
+    /**
+     * Test the decode method error with an invalid value.
+     *
+     * @return void
+     */
+    public function testDecodeError() : void
+    {
+        $this->expectException(XmlException::class);
+        Base64::decode('Zm9v!!!!');
+    }
+
+    /**
+     * Test the encode and decode workflow over RPC.
+     *
+     * @return void
+     */
+    public function testRoundTrip() : void
+    {
+        $encoded = RPC::encode(Map{'file' => Base64::fromString('foo bar')});
+
+        static::assertContains('<base64>Zm9vIGJhcg==</base64>', $encoded);
+        static::assertEquals(Map{'file' => 'foo bar'}, RPC::decode($encoded));
+    }
+
+    /**
+     * Test that only stream resources are encoded as base64.
+     *
+     * @return void
+     */
+    public function testNonStreamResource() : void
+    {
+        $parser = \xml_parser_create();
+
+        try {
+            RPC::encode($parser);
+
+            static::fail('A non stream resource was encoded.');
+        } catch (UnsupportedValueType $e) {
+            // Expected.
+        }
+
+        try {
+            $this->expectException(UnsupportedValueType::class);
+
+            Binary::encode($parser);
+        } finally {
+            \xml_parser_free($parser);
+        }
+    }
+}
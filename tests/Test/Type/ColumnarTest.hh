@@ -0,0 +1,122 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Type;
+
+use DOMDocument;
+use SimpleXMLElement;
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Type\Columnar;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+
+/**
+ * Test the columnar arrays of structs.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class ColumnarTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the fromNode method correct workflow, missing members are null.
+     *
+     * @return void
+     */
+    public function testFromNode() : void
+    {
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value>
+                        <struct>
+                            <member>
+                                <name>id</name>
+                                <value><int>1</int></value>
+                            </member>
+                            <member>
+                                <name>name</name>
+                                <value><string>foo</string></value>
+                            </member>
+                        </struct>
+                    </value>
+                    <value>
+                        <struct>
+                            <member>
+                                <name>id</name>
+                                <value><int>2</int></value>
+                            </member>
+                            <member>
+                                <name>tags</name>
+                                <value>
+                                    <array>
+                                        <data>
+                                            <value><string>bar</string></value>
+                                        </data>
+                                    </array>
+                                </value>
+                            </member>
+                        </struct>
+                    </value>
+                </data>
+            </array>
+        ');
+
+        $columnar = Columnar::fromNode($node, new DOMDocument());
+
+        static::assertNotNull($columnar);
+        invariant($columnar !== null, 'Columnar expected.');
+
+        static::assertSame(2, $columnar->getRowCount());
+        static::assertEquals(Vector{1, 2}, $columnar->getColumn('id'));
+        static::assertEquals(Vector{'foo', null}, $columnar->getColumn('name'));
+        static::assertEquals(Vector{null, Vector{'bar'}}, $columnar->getColumn('tags'));
+        static::assertEquals(
+            Map{'id' => 2, 'name' => null, 'tags' => Vector{'bar'}},
+            $columnar->getRow(1)
+        );
+    }
+
+    /**
+     * Test the fromNode method when the items are not all structs.
+     *
+     * @return void
+     */
+    public function testFromNodeMixed() : void
+    {
+        $node = new SimpleXMLElement('
+            <array>
+                <data>
+                    <value><struct></struct></value>
+                    <value><int>1</int></value>
+                </data>
+            </array>
+        ');
+
+        static::assertNull(Columnar::fromNode($node, new DOMDocument()));
+    }
+
+    /**
+     * Test rows whose structs do not match their <value> nodes one to one,
+     * even if their numbers do: they are decoded as the other modes do.
+     *
+     * @return void
+     */
+    public function testFromNodeUnevenRows() : void
+    {
+        $array = '<array><data>'
+            . '<value><struct></struct><struct></struct></value>'
+            . '<value></value>'
+            . '</data></array>';
+
+        static::assertNull(Columnar::fromNode(new SimpleXMLElement($array), new DOMDocument()));
+
+        $this->expectException(InvalidNodeException::class);
+
+        RPC::decode('<params><param><value>' . $array . '</value></param></params>', OutputMode::COLUMNAR);
+    }
+}
@@ -0,0 +1,105 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test\Type;
+
+use DateTimeImmutable;
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Exception\XmlException;
+
+/**
+ * Test the <dateTime.iso8601> values.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test\Type
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class TimestampTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the parse of the XML RPC format and of other ISO 8601 forms.
+     *
+     * @return void
+     */
+    public function testToEpoch() : void
+    {
+        static::assertSame(900684535, (new Timestamp('19980717T14:08:55'))->toEpoch());
+        static::assertSame(900684535, (new Timestamp('1998-07-17T16:08:55+02:00'))->toEpoch());
+    }
+
+    /**
+     * Test the parse error.
+     *
+     * @return void
+     */
+    public function testToDateTimeError() : void
+    {
+        $this->expectException(XmlException::class);
+        (new Timestamp('yesterday at noon-ish'))->toDateTime();
+    }
+
+    /**
+     * Test that the relative dates are not read as dates.
+     *
+     * @return void
+     */
+    public function testRelativeDates() : void
+    {
+        foreach (vec['now', 'yesterday', '+1 week'] as $lexeme) {
+            try {
+                (new Timestamp($lexeme))->toDateTime();
+
+                static::fail(\sprintf('"%s" was read as a date.', $lexeme));
+            } catch (XmlException $e) {
+                // Expected.
+            }
+        }
+    }
+
+    /**
+     * Test that the XML RPC format has no fraction of a second.
+     *
+     * @return void
+     */
+    public function testNoFraction() : void
+    {
+        static::assertSame('000000', (new Timestamp('19980717T14:08:55'))->toDateTime()->format('u'));
+    }
+
+    /**
+     * Test that the decoded value is written back untouched.
+     *
+     * @return void
+     */
+    public function testRoundTrip() : void
+    {
+        $xml = '<params><param><value><dateTime.iso8601>1998-07-17T14:08:55Z</dateTime.iso8601></value></param></params>';
+
+        $decoded = RPC::decode($xml);
+
+        static::assertInstanceOf(Timestamp::class, $decoded);
+        static::assertContains(
+            '<dateTime.iso8601>1998-07-17T14:08:55Z</dateTime.iso8601>',
+            RPC::encode($decoded)
+        );
+    }
+
+    /**
+     * Test the encode of a native date.
+     *
+     * @return void
+     */
+    public function testEncodeDateTime() : void
+    {
+        $date = new DateTimeImmutable('@900684535');
+
+        static::assertContains(
+            '<dateTime.iso8601>19980717T14:08:55</dateTime.iso8601>',
+            RPC::encode($date)
+        );
+    }
+}
@@ -0,0 +1,71 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\TypeRegistry;
+use Ivyhjk\Xml\Test\Fixture\Money;
+use Ivyhjk\Xml\Test\Fixture\Price;
+use Ivyhjk\Xml\Test\Fixture\MoneyHandler;
+
+/**
+ * Test the custom type handlers.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class TypeRegistryTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Remove the handlers registered by the tests.
+     *
+     * @return void
+     */
+    public function tearDown() : void
+    {
+        TypeRegistry::clear();
+    }
+
+    /**
+     * Test the handlers resolution.
+     *
+     * @return void
+     */
+    public function testGetEncoder() : void
+    {
+        $handler = new MoneyHandler();
+
+        TypeRegistry::registerEncoder(Money::class, $handler);
+
+        static::assertSame($handler, TypeRegistry::getEncoder(new Money(1, 'USD')));
+        static::assertSame($handler, TypeRegistry::getEncoder(new Price(1, 'USD')));
+        static::assertNull(TypeRegistry::getEncoder(Map{}));
+        static::assertNull(TypeRegistry::getEncoder('foo'));
+    }
+
+    /**
+     * Test the encode and decode workflow with a handler.
+     *
+     * @return void
+     */
+    public function testRoundTrip() : void
+    {
+        $handler = new MoneyHandler();
+
+        TypeRegistry::registerEncoder(Money::class, $handler);
+        TypeRegistry::registerDecoder('money', $handler);
+
+        $encoded = RPC::encode(Map{'price' => new Price(1337, 'EUR')});
+
+        static::assertContains('<money currency="EUR">1337</money>', $encoded);
+
+        $decoded = RPC::decode($encoded);
+
+        static::assertEquals(Map{'price' => new Money(1337, 'EUR')}, $decoded);
+    }
+}
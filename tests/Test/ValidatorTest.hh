@@ -0,0 +1,136 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\Contract\ValueType;
+
+/**
+ * Test the structure validation.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class ValidatorTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test valid documents.
+     *
+     * @return void
+     */
+    public function testValid() : void
+    {
+        $xml = RPC::encode(vec['foo', 1, 1.5, vec[1, 'a'], dict['a' => dict['b' => 'c']]]);
+
+        static::assertTrue(RPC::validate($xml)->isValid());
+        static::assertTrue(RPCRequest::validate(RPCRequest::encode('foo.bar', vec[1, 'a']))->isValid());
+    }
+
+    /**
+     * Test the grammar errors and their location.
+     *
+     * @return void
+     */
+    public function testInvalidGrammar() : void
+    {
+        $result = RPC::validate(
+            '<params><param><value><int>1</int></value></param>'
+            . '<param><value><struct><member><value><int>2</int></value></member></struct></value></param></params>'
+        );
+
+        static::assertFalse($result->isValid());
+        static::assertSame('Tag "name" not found into "member" node.', $result->getError());
+        static::assertSame('/params[1]/param[2]/value[1]/struct[1]/member[1]', $result->getPath());
+
+        $result = RPC::validate('<params><param><value><int>1a</int></value></param></params>');
+
+        static::assertFalse($result->isValid());
+        static::assertSame('/params[1]/param[1]/value[1]/int[1]', $result->getPath());
+
+        static::assertFalse(RPC::validate('<params><param><value/></param></params>')->isValid());
+        static::assertFalse(RPCRequest::validate('<params></params>')->isValid());
+    }
+
+    /**
+     * Test the well-formedness errors.
+     *
+     * @return void
+     */
+    public function testMalformed() : void
+    {
+        $result = RPC::validate("<params>\n<param><value><int>1</int></param></params>");
+
+        static::assertFalse($result->isValid());
+        static::assertSame(2, $result->getLine());
+    }
+
+    /**
+     * Test that the libxml warnings neither fail a document nor replace a
+     * grammar error, and the line of a grammar error.
+     *
+     * @return void
+     */
+    public function testWarnings() : void
+    {
+        // A relative namespace is a libxml warning.
+        static::assertTrue(RPC::validate('<params xmlns="foo"><param><value><int>1</int></value></param></params>')->isValid());
+
+        $result = RPC::validate(
+            "<params xmlns=\"foo\">\n<param><value><struct>\n<member><value><int>2</int></value></member>"
+            . '</struct></value></param></params>'
+        );
+
+        static::assertFalse($result->isValid());
+        static::assertSame('Tag "name" not found into "member" node.', $result->getError());
+        static::assertSame(3, $result->getLine());
+    }
+
+    /**
+     * Test the expected param types.
+     *
+     * @return void
+     */
+    public function testTypes() : void
+    {
+        $xml = RPC::encode(vec['foo', 1]);
+
+        static::assertTrue(RPC::validate($xml, Vector{ValueType::STRING, ValueType::I4})->isValid());
+
+        $result = RPC::validate($xml, Vector{ValueType::STRING, ValueType::STRUCT});
+
+        static::assertFalse($result->isValid());
+        static::assertSame('Expected "struct" and got "int".', $result->getError());
+    }
+
+    /**
+     * Test the values the decoder accepts beyond the single type tag and
+     * the compact dateTime.iso8601 lexeme.
+     *
+     * @return void
+     */
+    public function testDecoderLexemes() : void
+    {
+        $xml = '<params><param><value><int>1</int><string>a</string></value></param>'
+            . '<param><value><dateTime.iso8601> 2016-01-02T03:04:05.5+01:00 </dateTime.iso8601></value></param></params>';
+
+        static::assertTrue(RPC::validate($xml)->isValid());
+        static::assertTrue(RPC::validate($xml, Vector{ValueType::ARRAY, ValueType::DATETIME})->isValid());
+
+        $result = RPC::validate($xml, Vector{ValueType::INTEGER});
+
+        static::assertFalse($result->isValid());
+        static::assertSame('Expected "int" and got "array".', $result->getError());
+
+        $result = RPC::validate(
+            '<params><param><value><dateTime.iso8601>tomorrow</dateTime.iso8601></value></param></params>'
+        );
+
+        static::assertFalse($result->isValid());
+    }
+}
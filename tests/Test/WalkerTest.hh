@@ -0,0 +1,109 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\Walker;
+use Ivyhjk\Xml\Contract\OutputMode;
+use Ivyhjk\Xml\Visitor\ValueBuilder;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidNodeException;
+use Ivyhjk\Xml\Test\Fixture\RecordingVisitor;
+
+/**
+ * Test the document walk.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class WalkerTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the events order.
+     *
+     * @return void
+     */
+    public function testEvents() : void
+    {
+        $visitor = new RecordingVisitor();
+
+        Walker::walk(RPCRequest::encode('foo', vec[1, dict['a' => vec['b']], dict[]]), $visitor);
+
+        static::assertEquals(Vector{
+            'method:foo',
+            'param:0', 'int:1', '/param',
+            'param:1', 'struct', 'member:a', 'array', 'string:b', '/array', '/struct', '/param',
+            'param:2', 'struct', '/struct', '/param',
+        }, $visitor->events);
+    }
+
+    /**
+     * Test that the builder visitor decodes as RPC::decode.
+     *
+     * @return void
+     */
+    public function testValueBuilder() : void
+    {
+        $xml = RPC::encode(vec['foo', 1, 2.5, vec[1, vec['a', 'b']], dict['a' => dict['b' => 'c'], 'd' => vec[]]]);
+
+        $builder = new ValueBuilder();
+        RPC::visit($xml, $builder);
+
+        static::assertEquals(RPC::decode($xml), $builder->getResult());
+
+        $builder = new ValueBuilder(OutputMode::HACK_ARRAY);
+        RPC::visit($xml, $builder);
+
+        static::assertSame(RPC::decode($xml, OutputMode::HACK_ARRAY), $builder->getResult());
+    }
+
+    /**
+     * Test the walk of a malformed document.
+     *
+     * @return void
+     */
+    public function testMalformed() : void
+    {
+        $this->expectException(XmlException::class);
+
+        Walker::walk('<params><param><value><int>1</int></param></params>', new ValueBuilder());
+    }
+
+    /**
+     * Test a member without value.
+     *
+     * @return void
+     */
+    public function testMemberWithoutValue() : void
+    {
+        $this->expectException(InvalidNodeException::class);
+
+        Walker::walk(
+            '<params><param><value><struct><member><name>a</name></member></struct></value></param></params>',
+            new ValueBuilder()
+        );
+    }
+
+    /**
+     * Test a member with two values.
+     *
+     * @return void
+     */
+    public function testMemberWithTwoValues() : void
+    {
+        $this->expectException(InvalidNodeException::class);
+
+        Walker::walk(
+            '<params><param><value><struct><member><name>a</name>'
+                . '<value><int>1</int></value><value><int>2</int></value>'
+                . '</member></struct></value></param></params>',
+            new ValueBuilder()
+        );
+    }
+}
@@ -0,0 +1,244 @@
+<?hh // strict
+
+namespace Ivyhjk\Xml\Test;
+
+use Ivyhjk\Xml\RPC;
+use Ivyhjk\Xml\Config;
+use Ivyhjk\Xml\Writer;
+use Ivyhjk\Xml\RPCRequest;
+use Ivyhjk\Xml\Type\Base64;
+use Ivyhjk\Xml\Type\TypedList;
+use Ivyhjk\Xml\Type\Timestamp;
+use Ivyhjk\Xml\Contract\ValueType;
+use Ivyhjk\Xml\Exception\XmlException;
+use Ivyhjk\Xml\Exception\InvalidStateException;
+use Ivyhjk\Xml\Exception\DepthLimitExceeded;
+
+/**
+ * Test the push writer.
+ *
+ * @since v1.1.0
+ * @version v1.1.0
+ * @package Ivyhjk\Xml\Test
+ * @author Elvis Munoz <elvis.munoz.f@gmail.com>
+ * @copyright Copyright (c) 2016, Elvis Munoz
+ * @license https://opensource.org/licenses/MIT MIT License
+ */
+/* HH_FIXME[4123] */ /* HH_FIXME[2049] */
+class WriterTest extends \PHPUnit_Framework_TestCase
+{
+    /**
+     * Test the events output.
+     *
+     * @return void
+     */
+    public function testWrite() : void
+    {
+        $writer = new Writer();
+
+        $writer
+            ->startParams()
+                ->int(1)
+                ->startStruct()
+                    ->member('a')->string('b & c')
+                    ->member('d')->startArray()->int(2)->double(2.5)->end()
+                ->end()
+            ->end();
+
+        $expected = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<params>"
+            . '<param><value><int>1</int></value></param>'
+            . '<param><value><struct>'
+            . '<member><name>a</name><value><string>b &amp; c</string></value></member>'
+            . '<member><name>d</name><value><array><data>'
+            . '<value><int>2</int></value><value><double>2.5</double></value>'
+            . '</data></array></value></member>'
+            . '</struct></value></param>'
+            . "</params>\n";
+
+        static::assertSame($expected, $writer->getOutput());
+        static::assertEquals(
+            Vector{1, Map{'a' => 'b & c', 'd' => Vector{2, 2.5}}},
+            RPC::decode($writer->getOutput())
+        );
+    }
+
+    /**
+     * Test a request written into a stream with native values.
+     *
+     * @return void
+     */
+    public function testStream() : void
+    {
+        $stream = \fopen('php://memory', 'r+');
+
+        (new Writer($stream))
+            ->startMethodCall('foo.bar')
+                ->startParams()
+                    ->value(dict['a' => vec[1, 'b'], 'c' => Map{'d' => 1.5}])
+                ->end()
+            ->end();
+
+        \rewind($stream);
+
+        $decoded = RPCRequest::decode((string) \stream_get_contents($stream));
+
+        \fclose($stream);
+
+        static::assertSame('foo.bar', $decoded->at('method'));
+        static::assertEquals(
+            Vector{Map{'a' => Vector{1, 'b'}, 'c' => Map{'d' => 1.5}}},
+            $decoded->at('parameters')
+        );
+    }
+
+    /**
+     * Test that native values are written as the DOM encoder does.
+     *
+     * @return void
+     */
+    public function testValueRules() : void
+    {
+        $values = vec[[], Set{'x'}, new TypedList(ValueType::STRING, vec[1, 2]), [1 => 'a'], dict[]];
+
+        $writer = (new Writer())->startParams();
+
+        foreach ($values as $value) {
+            $writer->value($value);
+        }
+
+        static::assertEquals(RPC::decode(RPC::encode($values)), RPC::decode($writer->end()->getOutput()));
+    }
+
+    /**
+     * Test the base64 and date typed lists, written as the single values.
+     *
+     * @return void
+     */
+    public function testTypedListConversions() : void
+    {
+        $values = vec[
+            new TypedList(ValueType::BASE64, vec[Base64::fromString("\x00\xff"), 'ab']),
+            new TypedList(ValueType::DATETIME, vec[new Timestamp('20160101T10:20:30'), '20160102T00:00:00']),
+        ];
+
+        $writer = (new Writer())->startParams();
+
+        foreach ($values as $value) {
+            $writer->value($value);
+        }
+
+        $decoded = RPC::decode($writer->end()->getOutput());
+
+        static::assertEquals(RPC::decode(RPC::encode($values)), $decoded);
+        static::assertEquals(Vector{Vector{"\x00\xff", 'ab'}}, RPC::decode(RPC::encode(vec[$values[0]])));
+    }
+
+    /**
+     * Test that the structs of a typed list must share their members.
+     *
+     * @return void
+     */
+    public function testTypedListMembers() : void
+    {
+        $list = new TypedList(ValueType::STRUCT, vec[dict['a' => 1], dict['b' => 2]]);
+
+        try {
+            RPC::encode(vec[$list]);
+
+            static::fail('The DOM encoder accepted structs with other members.');
+        } catch (XmlException $e) {
+            static::assertSame('All the structs of the list must have the same members.', $e->getMessage());
+        }
+
+        $this->expectException(XmlException::class);
+
+        (new Writer())->startParams()->value($list);
+    }
+
+    /**
+     * Test the nesting checks.
+     *
+     * @return void
+     */
+    public function testInvalidNesting() : void
+    {
+        $writer = (new Writer())->startParams()->startStruct();
+
+        $this->expectException(InvalidStateException::class);
+
+        $writer->int(1);
+    }
+
+    /**
+     * Test the output of an unfinished document.
+     *
+     * @return void
+     */
+    public function testIncompleteOutput() : void
+    {
+        $this->expectException(InvalidStateException::class);
+
+        (new Writer())->startParams()->getOutput();
+    }
+
+    /**
+     * Test the members order in canonical mode.
+     *
+     * @return void
+     */
+    public function testCanonicalMemberOrder() : void
+    {
+        $writer = (new Writer())->canonical()->startParams()->startStruct()->member('b')->int(1);
+
+        $this->expectException(InvalidStateException::class);
+
+        $writer->member('a');
+    }
+
+    /**
+     * Test that the writer and the DOM encoder share the depth limit, at the
+     * limit and one level beyond, for containers and scalars.
+     *
+     * @return void
+     */
+    public function testDepthLimit() : void
+    {
+        // The innermost values are at level 4, and then 5.
+        $atLimit = vec[
+            dict['a' => dict['b' => vec[1]]],
+            dict['a' => dict['b' => dict['c' => dict[]]]],
+        ];
+        $overLimit = vec[
+            dict['a' => dict['b' => vec[vec[1]]]],
+            dict['a' => dict['b' => dict['c' => dict['d' => 'e']]]],
+            dict['a' => dict['b' => dict['c' => dict['d' => dict[]]]]],
+        ];
+
+        $encoders = vec[
+            (mixed $value) ==> RPC::encode(vec[$value]),
+            (mixed $value) ==> RPC::encodeCanonical(vec[$value]),
+        ];
+
+        Config::setMaxDepth(4);
+
+        try {
+            foreach ($atLimit as $value) {
+                static::assertEquals(RPC::decode($encoders[0]($value)), RPC::decode($encoders[1]($value)));
+            }
+
+            foreach ($overLimit as $value) {
+                foreach ($encoders as $encoder) {
+                    try {
+                        $encoder($value);
+
+                        static::fail('A value beyond the depth limit was encoded.');
+                    } catch (DepthLimitExceeded $e) {
+                        static::assertSame('Maximum nesting depth of 4 exceeded.', $e->getMessage());
+                    }
+                }
+            }
+        } finally {
+            Config::setMaxDepth(Config::DEFAULT_MAX_DEPTH);
+        }
+    }
+}